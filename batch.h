@@ -0,0 +1,249 @@
+/**
+ * @file batch.h
+ * @author Andrew Wang (siweiw9@gmail.com)
+ * @brief Structure-of-arrays batch kernels for dense rational data.
+ * @version 0.1
+ * @date 2022-02-26
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "rational.h"
+
+/**
+ * @brief Elementwise kernels over separated numerator/denominator arrays.
+ *
+ * The interleaved layout of rational_t defeats auto-vectorization, so
+ * this namespace stores numerators and denominators in separate
+ * contiguous arrays. The arithmetic kernels are plain countable loops
+ * over those arrays with no per-element gcd, which lets the compiler
+ * fill SIMD lanes; reduction is deferred to an explicit normalize pass.
+ */
+namespace batch {
+
+/**
+ * @brief Structure-of-arrays container for a sequence of rationals.
+ *
+ * Components of element i live at num[i] and denom[i]. Elements written
+ * by the arithmetic kernels are unreduced until normalize() runs.
+ *
+ * @tparam T The integer type of the numerators and denominators.
+ */
+template <class T>
+struct soa {
+  std::vector<T> num;
+  std::vector<T> denom;
+
+  /**
+   * @brief Construct an empty container.
+   *
+   */
+  soa() = default;
+
+  /**
+   * @brief Construct a container of count copies of the given rational.
+   *
+   * @param count The number of elements.
+   * @param frac The fill value.
+   */
+  soa(std::size_t count, const rational_t<T>& frac)
+      : num(count, frac.numerator()), denom(count, frac.denominator()) {}
+
+  /**
+   * @brief Number of rationals held.
+   *
+   * @return element count.
+   */
+  std::size_t size() const { return num.size(); }
+
+  /**
+   * @brief Append a rational to the container.
+   *
+   * @param frac The rational to append.
+   */
+  void push_back(const rational_t<T>& frac) {
+    num.push_back(frac.numerator());
+    denom.push_back(frac.denominator());
+  }
+
+  /**
+   * @brief Materialize element index as a reduced rational.
+   *
+   * @param index The element position.
+   * @return rational at the given position.
+   */
+  rational_t<T> at(std::size_t index) const {
+    return rational_t<T>(num.at(index), denom.at(index));
+  }
+};
+
+/**
+ * @brief Elementwise addition over raw component arrays. dst = a + b.
+ *
+ * Results are unreduced; run normalize over the destination when
+ * canonical form is needed.
+ *
+ * @param dst_num Destination numerators.
+ * @param dst_denom Destination denominators.
+ * @param a_num Left operand numerators.
+ * @param a_denom Left operand denominators.
+ * @param b_num Right operand numerators.
+ * @param b_denom Right operand denominators.
+ * @param count Number of elements.
+ */
+template <class T>
+void add(T* dst_num, T* dst_denom, const T* a_num, const T* a_denom,
+         const T* b_num, const T* b_denom, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    dst_num[i] = static_cast<T>(a_num[i] * b_denom[i] + a_denom[i] * b_num[i]);
+    dst_denom[i] = static_cast<T>(a_denom[i] * b_denom[i]);
+  }
+}
+
+/**
+ * @brief Elementwise subtraction over raw component arrays. dst = a - b.
+ *
+ * Results are unreduced; run normalize over the destination when
+ * canonical form is needed.
+ *
+ * @param dst_num Destination numerators.
+ * @param dst_denom Destination denominators.
+ * @param a_num Left operand numerators.
+ * @param a_denom Left operand denominators.
+ * @param b_num Right operand numerators.
+ * @param b_denom Right operand denominators.
+ * @param count Number of elements.
+ */
+template <class T>
+void sub(T* dst_num, T* dst_denom, const T* a_num, const T* a_denom,
+         const T* b_num, const T* b_denom, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    dst_num[i] = static_cast<T>(a_num[i] * b_denom[i] - a_denom[i] * b_num[i]);
+    dst_denom[i] = static_cast<T>(a_denom[i] * b_denom[i]);
+  }
+}
+
+/**
+ * @brief Elementwise multiplication over raw component arrays. dst = a * b.
+ *
+ * Results are unreduced; run normalize over the destination when
+ * canonical form is needed.
+ *
+ * @param dst_num Destination numerators.
+ * @param dst_denom Destination denominators.
+ * @param a_num Left operand numerators.
+ * @param a_denom Left operand denominators.
+ * @param b_num Right operand numerators.
+ * @param b_denom Right operand denominators.
+ * @param count Number of elements.
+ */
+template <class T>
+void mul(T* dst_num, T* dst_denom, const T* a_num, const T* a_denom,
+         const T* b_num, const T* b_denom, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    dst_num[i] = static_cast<T>(a_num[i] * b_num[i]);
+    dst_denom[i] = static_cast<T>(a_denom[i] * b_denom[i]);
+  }
+}
+
+/**
+ * @brief Elementwise less-than over raw component arrays. mask = a < b.
+ *
+ * Requires positive denominators, which both the rational_t constructors
+ * and normalize guarantee, so a single cross-multiplied compare per lane
+ * suffices.
+ *
+ * @param mask Destination flags, 1 where a[i] < b[i] and 0 elsewhere.
+ * @param a_num Left operand numerators.
+ * @param a_denom Left operand denominators.
+ * @param b_num Right operand numerators.
+ * @param b_denom Right operand denominators.
+ * @param count Number of elements.
+ */
+template <class T>
+void less(std::uint8_t* mask, const T* a_num, const T* a_denom, const T* b_num,
+          const T* b_denom, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i) {
+    mask[i] = a_num[i] * b_denom[i] < b_num[i] * a_denom[i] ? 1 : 0;
+  }
+}
+
+/**
+ * @brief Reduce every element to canonical form in one scalar pass.
+ *
+ * @param values The container whose elements are reduced.
+ */
+template <class T>
+void normalize(soa<T>& values) {
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    const auto frac = rational_t<T>(values.num[i], values.denom[i]);
+    values.num[i] = frac.numerator();
+    values.denom[i] = frac.denominator();
+  }
+}
+
+/**
+ * @brief Elementwise addition over containers. dst = a + b, unreduced.
+ *
+ * @param dst The destination container, resized to match.
+ * @param a Left operand container.
+ * @param b Right operand container.
+ */
+template <class T>
+void add(soa<T>& dst, const soa<T>& a, const soa<T>& b) {
+  dst.num.resize(a.size());
+  dst.denom.resize(a.size());
+  add(dst.num.data(), dst.denom.data(), a.num.data(), a.denom.data(),
+      b.num.data(), b.denom.data(), a.size());
+}
+
+/**
+ * @brief Elementwise subtraction over containers. dst = a - b, unreduced.
+ *
+ * @param dst The destination container, resized to match.
+ * @param a Left operand container.
+ * @param b Right operand container.
+ */
+template <class T>
+void sub(soa<T>& dst, const soa<T>& a, const soa<T>& b) {
+  dst.num.resize(a.size());
+  dst.denom.resize(a.size());
+  sub(dst.num.data(), dst.denom.data(), a.num.data(), a.denom.data(),
+      b.num.data(), b.denom.data(), a.size());
+}
+
+/**
+ * @brief Elementwise multiplication over containers. dst = a * b, unreduced.
+ *
+ * @param dst The destination container, resized to match.
+ * @param a Left operand container.
+ * @param b Right operand container.
+ */
+template <class T>
+void mul(soa<T>& dst, const soa<T>& a, const soa<T>& b) {
+  dst.num.resize(a.size());
+  dst.denom.resize(a.size());
+  mul(dst.num.data(), dst.denom.data(), a.num.data(), a.denom.data(),
+      b.num.data(), b.denom.data(), a.size());
+}
+
+/**
+ * @brief Elementwise less-than over containers. mask = a < b.
+ *
+ * @param mask The destination flags, resized to match.
+ * @param a Left operand container.
+ * @param b Right operand container.
+ */
+template <class T>
+void less(std::vector<std::uint8_t>& mask, const soa<T>& a, const soa<T>& b) {
+  mask.resize(a.size());
+  less(mask.data(), a.num.data(), a.denom.data(), b.num.data(), b.denom.data(),
+       a.size());
+}
+
+}  // namespace batch
@@ -0,0 +1,217 @@
+/**
+ * @file bench.cpp
+ * @author Andrew Wang (siweiw9@gmail.com)
+ * @brief Microbenchmarks for the rational hot paths.
+ * @version 0.1
+ * @date 2022-02-26
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "rational.h"
+using std::cout;
+using std::mt19937_64;
+using std::size_t;
+using std::uniform_int_distribution;
+using std::vector;
+using std::chrono::duration;
+using std::chrono::steady_clock;
+
+namespace bench {
+
+/**
+ * @brief Number of element operations per timed repetition.
+ *
+ */
+constexpr size_t op_count = 1 << 16;
+
+/**
+ * @brief Timed repetitions per benchmark; the median is reported.
+ *
+ */
+constexpr size_t repetitions = 9;
+
+/**
+ * @brief Accumulator the optimizer cannot delete results into.
+ *
+ */
+volatile std::int64_t sink = 0;
+
+/**
+ * @brief Time a body with warmup and median-of-N reporting.
+ *
+ * The body runs twice untimed to warm caches and the branch predictor,
+ * then repetitions times under the clock. The median wall time divided
+ * by op_count is printed as nanoseconds per operation.
+ *
+ * @param name The benchmark label.
+ * @param body Callable returning an integer folded into the sink.
+ */
+template <class F>
+void run(const char* name, F&& body) {
+  sink += body();
+  sink += body();
+  vector<double> times;
+  times.reserve(repetitions);
+  for (size_t rep = 0; rep < repetitions; ++rep) {
+    const auto begin = steady_clock::now();
+    sink += body();
+    const auto end = steady_clock::now();
+    times.push_back(duration<double, std::nano>(end - begin).count());
+  }
+  std::nth_element(times.begin(), times.begin() + repetitions / 2,
+                   times.end());
+  cout << name << ": " << times[repetitions / 2] / static_cast<double>(op_count)
+       << " ns/op\n";
+}
+
+/**
+ * @brief Deterministic rationals with small co-prime components.
+ *
+ * @return vector of op_count reduced rationals.
+ */
+vector<rational> small_coprime() {
+  mt19937_64 gen(7);
+  uniform_int_distribution<rational::integer_t> dist(1, 1000);
+  vector<rational> values;
+  values.reserve(op_count);
+  for (size_t i = 0; i < op_count; ++i) {
+    values.emplace_back(dist(gen), dist(gen));
+  }
+  return values;
+}
+
+/**
+ * @brief Deterministic rationals with power-of-two denominators.
+ *
+ * @return vector of op_count reduced rationals.
+ */
+vector<rational> pow2_denoms() {
+  mt19937_64 gen(11);
+  uniform_int_distribution<rational::integer_t> num_dist(-4096, 4096);
+  uniform_int_distribution<rational::integer_t> shift_dist(1, 20);
+  vector<rational> values;
+  values.reserve(op_count);
+  for (size_t i = 0; i < op_count; ++i) {
+    values.emplace_back(num_dist(gen),
+                        rational::integer_t(1) << shift_dist(gen));
+  }
+  return values;
+}
+
+/**
+ * @brief Deterministic rationals with near-overflow magnitudes.
+ *
+ * @return vector of op_count reduced rationals.
+ */
+vector<rational> near_overflow() {
+  mt19937_64 gen(13);
+  uniform_int_distribution<rational::integer_t> dist(1000000000, 2000000000);
+  vector<rational> values;
+  values.reserve(op_count);
+  for (size_t i = 0; i < op_count; ++i) {
+    values.emplace_back(dist(gen), dist(gen));
+  }
+  return values;
+}
+
+/**
+ * @brief Benchmark operator+= pairwise over a distribution.
+ *
+ * @param name The benchmark label.
+ * @param values The operand distribution.
+ */
+void bench_add(const char* name, const vector<rational>& values) {
+  run(name, [&values]() {
+    std::int64_t folded = 0;
+    for (size_t i = 0; i + 1 < values.size(); i += 2) {
+      auto acc = values[i];
+      acc += values[i + 1];
+      folded += acc.numerator();
+    }
+    return folded;
+  });
+}
+
+/**
+ * @brief Benchmark operator*= pairwise over a distribution.
+ *
+ * @param name The benchmark label.
+ * @param values The operand distribution.
+ */
+void bench_mul(const char* name, const vector<rational>& values) {
+  run(name, [&values]() {
+    std::int64_t folded = 0;
+    for (size_t i = 0; i + 1 < values.size(); i += 2) {
+      auto acc = values[i];
+      acc *= values[i + 1];
+      folded += acc.numerator();
+    }
+    return folded;
+  });
+}
+
+/**
+ * @brief Benchmark operator< pairwise over a distribution.
+ *
+ * @param name The benchmark label.
+ * @param values The operand distribution.
+ */
+void bench_less(const char* name, const vector<rational>& values) {
+  run(name, [&values]() {
+    std::int64_t folded = 0;
+    for (size_t i = 0; i + 1 < values.size(); i += 2) {
+      folded += values[i] < values[i + 1] ? 1 : 0;
+    }
+    return folded;
+  });
+}
+
+/**
+ * @brief Benchmark construction with simplify over a distribution.
+ *
+ * @param name The benchmark label.
+ * @param values The component source distribution.
+ */
+void bench_construct(const char* name, const vector<rational>& values) {
+  run(name, [&values]() {
+    std::int64_t folded = 0;
+    for (size_t i = 0; i + 1 < values.size(); i += 2) {
+      const rational frac(values[i].numerator() + 1,
+                          values[i + 1].denominator() + 1);
+      folded += frac.denominator();
+    }
+    return folded;
+  });
+}
+
+}  // namespace bench
+
+int main() {
+  const auto coprime = bench::small_coprime();
+  const auto pow2 = bench::pow2_denoms();
+  const auto huge = bench::near_overflow();
+
+  bench::bench_add("add/small_coprime", coprime);
+  bench::bench_add("add/pow2_denoms", pow2);
+  bench::bench_add("add/near_overflow", huge);
+
+  bench::bench_mul("mul/small_coprime", coprime);
+  bench::bench_mul("mul/pow2_denoms", pow2);
+
+  bench::bench_less("less/small_coprime", coprime);
+  bench::bench_less("less/pow2_denoms", pow2);
+
+  bench::bench_construct("construct/small_coprime", coprime);
+  bench::bench_construct("construct/near_overflow", huge);
+
+  cout << "sink: " << bench::sink << '\n';
+}
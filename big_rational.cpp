@@ -0,0 +1,477 @@
+/**
+ * @file big_rational.cpp
+ * @author Andrew Wang (siweiw9@gmail.com)
+ * @brief Implementation of arbitrary-precision rationals.
+ * @version 0.1
+ * @date 2022-02-26
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#include "big_rational.h"
+
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+using std::int64_t;
+using std::invalid_argument;
+using std::numeric_limits;
+using std::ostream;
+using std::string;
+using std::uint32_t;
+using std::uint64_t;
+using std::vector;
+
+namespace {
+
+/**
+ * @brief Magnitude of a signed 64-bit value without overflow at the minimum.
+ *
+ * @param value The signed value.
+ * @return |value| as an unsigned 64-bit integer.
+ */
+uint64_t abs_u64(int64_t value) {
+  return value < 0 ? 0 - static_cast<uint64_t>(value)
+                   : static_cast<uint64_t>(value);
+}
+
+/**
+ * @brief Euclidean gcd over unsigned 64-bit values.
+ *
+ * @param first The first value.
+ * @param second The second value.
+ * @return gcd(first, second)
+ */
+uint64_t gcd_u64(uint64_t first, uint64_t second) {
+  while (second != 0) {
+    const auto rem = first % second;
+    first = second;
+    second = rem;
+  }
+  return first;
+}
+
+}  // namespace
+
+void bigint::trim(vector<limb_t>& mag) {
+  while (!mag.empty() && mag.back() == 0) mag.pop_back();
+}
+
+int bigint::compare(const vector<limb_t>& left, const vector<limb_t>& right) {
+  if (left.size() != right.size()) {
+    return left.size() < right.size() ? -1 : 1;
+  }
+  for (auto i = left.size(); i-- > 0;) {
+    if (left[i] != right[i]) return left[i] < right[i] ? -1 : 1;
+  }
+  return 0;
+}
+
+void bigint::add_mag(vector<limb_t>& left, const vector<limb_t>& right) {
+  if (left.size() < right.size()) left.resize(right.size(), 0);
+  uint64_t carry = 0;
+  for (std::size_t i = 0; i < left.size(); ++i) {
+    carry += left[i];
+    if (i < right.size()) carry += right[i];
+    left[i] = static_cast<limb_t>(carry);
+    carry >>= 32;
+  }
+  if (carry != 0) left.push_back(static_cast<limb_t>(carry));
+}
+
+void bigint::sub_mag(vector<limb_t>& left, const vector<limb_t>& right) {
+  uint64_t borrow = 0;
+  for (std::size_t i = 0; i < left.size(); ++i) {
+    uint64_t take = borrow;
+    if (i < right.size()) take += right[i];
+    const uint64_t have = left[i];
+    left[i] = static_cast<limb_t>(have - take);
+    borrow = have < take ? 1 : 0;
+  }
+  trim(left);
+}
+
+vector<bigint::limb_t> bigint::mul_mag(const vector<limb_t>& left,
+                                       const vector<limb_t>& right) {
+  if (left.empty() || right.empty()) return {};
+  vector<limb_t> result(left.size() + right.size(), 0);
+  for (std::size_t i = 0; i < left.size(); ++i) {
+    uint64_t carry = 0;
+    for (std::size_t j = 0; j < right.size(); ++j) {
+      carry += static_cast<uint64_t>(left[i]) * right[j] + result[i + j];
+      result[i + j] = static_cast<limb_t>(carry);
+      carry >>= 32;
+    }
+    result[i + right.size()] = static_cast<limb_t>(carry);
+  }
+  trim(result);
+  return result;
+}
+
+void bigint::divmod_mag(const vector<limb_t>& dividend,
+                        const vector<limb_t>& divisor, vector<limb_t>& quot,
+                        vector<limb_t>& rem) {
+  quot.assign(dividend.size(), 0);
+  rem.clear();
+  for (auto i = dividend.size(); i-- > 0;) {
+    for (int bit = 31; bit >= 0; --bit) {
+      limb_t carry = (dividend[i] >> bit) & 1;
+      for (auto& limb : rem) {
+        const limb_t shifted = (limb << 1) | carry;
+        carry = limb >> 31;
+        limb = shifted;
+      }
+      if (carry != 0) rem.push_back(carry);
+      if (compare(rem, divisor) >= 0) {
+        sub_mag(rem, divisor);
+        quot[i] |= static_cast<limb_t>(1) << bit;
+      }
+    }
+  }
+  trim(quot);
+}
+
+vector<bigint::limb_t> bigint::magnitude() const {
+  if (!is_small()) return limbs;
+  const auto mag = abs_u64(small);
+  vector<limb_t> result{static_cast<limb_t>(mag),
+                        static_cast<limb_t>(mag >> 32)};
+  trim(result);
+  return result;
+}
+
+void bigint::assign(bool neg, vector<limb_t>&& mag) {
+  trim(mag);
+  if (mag.size() <= 2) {
+    uint64_t value = mag.empty() ? 0 : mag[0];
+    if (mag.size() == 2) value |= static_cast<uint64_t>(mag[1]) << 32;
+    const uint64_t small_max =
+        neg ? abs_u64(numeric_limits<int64_t>::min())
+            : static_cast<uint64_t>(numeric_limits<int64_t>::max());
+    if (value <= small_max) {
+      small = neg ? static_cast<int64_t>(0 - value)
+                  : static_cast<int64_t>(value);
+      limbs.clear();
+      return;
+    }
+  }
+  limbs = std::move(mag);
+  negative = neg;
+}
+
+bigint::bigint() : small(0), negative(false) {}
+
+bigint::bigint(int64_t value) : small(value), negative(false) {}
+
+bool bigint::is_small() const { return limbs.empty(); }
+
+bool bigint::is_zero() const { return is_small() && small == 0; }
+
+int bigint::sign() const {
+  if (is_small()) return small == 0 ? 0 : (small < 0 ? -1 : 1);
+  return negative ? -1 : 1;
+}
+
+int64_t bigint::to_int64() const { return small; }
+
+double bigint::to_double() const {
+  if (is_small()) return static_cast<double>(small);
+  double result = 0.0;
+  for (auto i = limbs.size(); i-- > 0;) {
+    result = result * 4294967296.0 + static_cast<double>(limbs[i]);
+  }
+  return negative ? -result : result;
+}
+
+void bigint::negate() {
+  if (!is_small()) {
+    negative = !negative;
+  } else if (small == numeric_limits<int64_t>::min()) {
+    assign(false, magnitude());
+  } else {
+    small = -small;
+  }
+}
+
+bigint& bigint::operator+=(const bigint& other) {
+  if (is_small() && other.is_small()) {
+    int64_t result = 0;
+    if (!__builtin_add_overflow(small, other.small, &result)) {
+      small = result;
+      return *this;
+    }
+  }
+  const auto left_neg = sign() < 0;
+  const auto right_neg = other.sign() < 0;
+  auto left_mag = magnitude();
+  const auto right_mag = other.magnitude();
+  if (left_neg == right_neg) {
+    add_mag(left_mag, right_mag);
+    assign(left_neg, std::move(left_mag));
+  } else if (compare(left_mag, right_mag) >= 0) {
+    sub_mag(left_mag, right_mag);
+    assign(left_neg, std::move(left_mag));
+  } else {
+    auto result = right_mag;
+    sub_mag(result, left_mag);
+    assign(right_neg, std::move(result));
+  }
+  return *this;
+}
+
+bigint& bigint::operator-=(const bigint& other) {
+  if (is_small() && other.is_small()) {
+    int64_t result = 0;
+    if (!__builtin_sub_overflow(small, other.small, &result)) {
+      small = result;
+      return *this;
+    }
+  }
+  auto negated = other;
+  negated.negate();
+  return operator+=(negated);
+}
+
+bigint& bigint::operator*=(const bigint& other) {
+  if (is_small() && other.is_small()) {
+    int64_t result = 0;
+    if (!__builtin_mul_overflow(small, other.small, &result)) {
+      small = result;
+      return *this;
+    }
+  }
+  const auto neg = (sign() < 0) != (other.sign() < 0);
+  assign(neg, mul_mag(magnitude(), other.magnitude()));
+  return *this;
+}
+
+void bigint::divmod(const bigint& dividend, const bigint& divisor,
+                    bigint& quot, bigint& rem) {
+  if (divisor.is_zero()) {
+    throw invalid_argument("Cannot divide by zero.");
+  }
+  if (dividend.is_small() && divisor.is_small() &&
+      !(dividend.small == numeric_limits<int64_t>::min() &&
+        divisor.small == -1)) {
+    quot = bigint(dividend.small / divisor.small);
+    rem = bigint(dividend.small % divisor.small);
+    return;
+  }
+  vector<limb_t> quot_mag;
+  vector<limb_t> rem_mag;
+  divmod_mag(dividend.magnitude(), divisor.magnitude(), quot_mag, rem_mag);
+  quot.assign((dividend.sign() < 0) != (divisor.sign() < 0),
+              std::move(quot_mag));
+  rem.assign(dividend.sign() < 0, std::move(rem_mag));
+}
+
+bigint bigint::gcd(const bigint& left, const bigint& right) {
+  if (left.is_small() && right.is_small()) {
+    const auto result = gcd_u64(abs_u64(left.small), abs_u64(right.small));
+    if (result <= static_cast<uint64_t>(numeric_limits<int64_t>::max())) {
+      return bigint(static_cast<int64_t>(result));
+    }
+  }
+  auto a = left.magnitude();
+  auto b = right.magnitude();
+  while (!b.empty()) {
+    vector<limb_t> quot_mag;
+    vector<limb_t> rem_mag;
+    divmod_mag(a, b, quot_mag, rem_mag);
+    a = std::move(b);
+    b = std::move(rem_mag);
+  }
+  bigint result;
+  result.assign(false, std::move(a));
+  return result;
+}
+
+bigint operator+(bigint left, const bigint& right) {
+  left += right;
+  return left;
+}
+
+bigint operator-(bigint left, const bigint& right) {
+  left -= right;
+  return left;
+}
+
+bigint operator*(bigint left, const bigint& right) {
+  left *= right;
+  return left;
+}
+
+bigint operator/(const bigint& left, const bigint& right) {
+  bigint quot;
+  bigint rem;
+  bigint::divmod(left, right, quot, rem);
+  return quot;
+}
+
+bool operator==(const bigint& left, const bigint& right) {
+  if (left.is_small() != right.is_small()) return false;
+  if (left.is_small()) return left.small == right.small;
+  return left.negative == right.negative &&
+         bigint::compare(left.limbs, right.limbs) == 0;
+}
+
+bool operator!=(const bigint& left, const bigint& right) {
+  return !(left == right);
+}
+
+bool operator<(const bigint& left, const bigint& right) {
+  const auto left_sign = left.sign();
+  const auto right_sign = right.sign();
+  if (left_sign != right_sign) return left_sign < right_sign;
+  if (left.is_small() && right.is_small()) return left.small < right.small;
+  // A heap magnitude always exceeds any inline magnitude.
+  if (left.is_small() != right.is_small()) {
+    return left.is_small() ? right_sign > 0 : left_sign < 0;
+  }
+  const auto order = bigint::compare(left.limbs, right.limbs);
+  return left_sign < 0 ? order > 0 : order < 0;
+}
+
+ostream& operator<<(ostream& out, const bigint& value) {
+  if (value.is_small()) return out << value.small;
+  // Peel 9 decimal digits at a time by dividing the magnitude by 1e9.
+  constexpr uint64_t chunk = 1000000000;
+  auto mag = value.limbs;
+  string digits;
+  while (!mag.empty()) {
+    uint64_t rem = 0;
+    for (auto i = mag.size(); i-- > 0;) {
+      const auto cur = (rem << 32) | mag[i];
+      mag[i] = static_cast<bigint::limb_t>(cur / chunk);
+      rem = cur % chunk;
+    }
+    bigint::trim(mag);
+    auto part = std::to_string(rem);
+    if (!mag.empty()) part.insert(0, 9 - part.size(), '0');
+    digits.insert(0, part);
+  }
+  if (value.negative) out << '-';
+  return out << digits;
+}
+
+void big_rational::simplify() {
+  if (denom.sign() < 0) {
+    num.negate();
+    denom.negate();
+  }
+  const auto div = bigint::gcd(num, denom);
+  if (div != bigint(1)) {
+    num = num / div;
+    denom = denom / div;
+  }
+}
+
+big_rational::big_rational(int64_t value) : num(value), denom(1) {}
+
+big_rational::big_rational(bigint numerator, bigint denominator)
+    : num(std::move(numerator)), denom(std::move(denominator)) {
+  if (denom.is_zero()) {
+    throw invalid_argument("Denominator must be non-zero.");
+  }
+  simplify();
+}
+
+big_rational::big_rational(const rational& frac)
+    : num(frac.numerator()), denom(frac.denominator()) {}
+
+const bigint& big_rational::numerator() const { return num; }
+
+const bigint& big_rational::denominator() const { return denom; }
+
+double big_rational::value() const {
+  return num.to_double() / denom.to_double();
+}
+
+big_rational big_rational::operator-() const {
+  auto result = *this;
+  result.num.negate();
+  return result;
+}
+
+big_rational& big_rational::operator+=(const big_rational& other) {
+  num = num * other.denom + denom * other.num;
+  denom *= other.denom;
+  simplify();
+  return *this;
+}
+
+big_rational operator+(big_rational left, const big_rational& right) {
+  left += right;
+  return left;
+}
+
+big_rational& big_rational::operator-=(const big_rational& other) {
+  num = num * other.denom - denom * other.num;
+  denom *= other.denom;
+  simplify();
+  return *this;
+}
+
+big_rational operator-(big_rational left, const big_rational& right) {
+  left -= right;
+  return left;
+}
+
+big_rational& big_rational::operator*=(const big_rational& other) {
+  num *= other.num;
+  denom *= other.denom;
+  simplify();
+  return *this;
+}
+
+big_rational operator*(big_rational left, const big_rational& right) {
+  left *= right;
+  return left;
+}
+
+big_rational& big_rational::operator/=(const big_rational& other) {
+  if (other.num.is_zero()) {
+    throw invalid_argument("Cannot divide by zero.");
+  }
+  num *= other.denom;
+  denom *= other.num;
+  simplify();
+  return *this;
+}
+
+big_rational operator/(big_rational left, const big_rational& right) {
+  left /= right;
+  return left;
+}
+
+bool operator==(const big_rational& left, const big_rational& right) {
+  return left.num == right.num && left.denom == right.denom;
+}
+
+bool operator!=(const big_rational& left, const big_rational& right) {
+  return !(left == right);
+}
+
+bool operator<(const big_rational& left, const big_rational& right) {
+  return left.num * right.denom < right.num * left.denom;
+}
+
+bool operator<=(const big_rational& left, const big_rational& right) {
+  return !(right < left);
+}
+
+bool operator>(const big_rational& left, const big_rational& right) {
+  return right < left;
+}
+
+bool operator>=(const big_rational& left, const big_rational& right) {
+  return !(left < right);
+}
+
+ostream& operator<<(ostream& out, const big_rational& frac) {
+  return out << frac.num << '/' << frac.denom;
+}
@@ -0,0 +1,505 @@
+/**
+ * @file big_rational.h
+ * @author Andrew Wang (siweiw9@gmail.com)
+ * @brief Arbitrary-precision rational with small-value inline storage.
+ * @version 0.1
+ * @date 2022-02-26
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "rational.h"
+
+/**
+ * @brief Signed integer of unbounded range with small-value inline storage.
+ *
+ * Values whose magnitude fits in 64 bits live in an inline field with no
+ * heap allocation; only results that overflow spill into heap limbs.
+ * Arithmetic takes the inline fast path with overflow-checked builtins
+ * and promotes on demand, so the long tail gets correctness while the
+ * common case pays no allocation or indirection.
+ */
+class bigint {
+ private:
+  using limb_t = std::uint32_t;
+
+  /**
+   * @brief Inline value. Authoritative whenever limbs is empty.
+   *
+   */
+  std::int64_t small;
+
+  /**
+   * @brief Sign of the heap form. Meaningless while limbs is empty.
+   *
+   */
+  bool negative;
+
+  /**
+   * @brief Magnitude in base 2^32 limbs, least significant first.
+   *
+   * Empty for the inline form. Non-empty magnitudes always exceed the
+   * inline range; demote() restores that invariant after arithmetic.
+   */
+  std::vector<limb_t> limbs;
+
+  /**
+   * @brief Remove leading zero limbs.
+   *
+   * @param mag The magnitude to trim.
+   */
+  static void trim(std::vector<limb_t>& mag);
+
+  /**
+   * @brief Compare magnitudes.
+   *
+   * @param left The first magnitude.
+   * @param right The second magnitude.
+   * @return negative, zero, or positive as left <, ==, > right.
+   */
+  static int compare(const std::vector<limb_t>& left,
+                     const std::vector<limb_t>& right);
+
+  /**
+   * @brief Magnitude addition. left += right.
+   *
+   * @param left The accumulating magnitude.
+   * @param right The added magnitude.
+   */
+  static void add_mag(std::vector<limb_t>& left,
+                      const std::vector<limb_t>& right);
+
+  /**
+   * @brief Magnitude subtraction. left -= right. Requires left >= right.
+   *
+   * @param left The accumulating magnitude.
+   * @param right The subtracted magnitude.
+   */
+  static void sub_mag(std::vector<limb_t>& left,
+                      const std::vector<limb_t>& right);
+
+  /**
+   * @brief Schoolbook magnitude multiplication.
+   *
+   * @param left The first magnitude.
+   * @param right The second magnitude.
+   * @return left * right.
+   */
+  static std::vector<limb_t> mul_mag(const std::vector<limb_t>& left,
+                                     const std::vector<limb_t>& right);
+
+  /**
+   * @brief Shift-subtract magnitude division.
+   *
+   * Bit-serial restoring division: compact and exact, and fast enough
+   * for the just-past-64-bit magnitudes this type exists for.
+   *
+   * @param dividend The dividend magnitude.
+   * @param divisor The divisor magnitude. Must be non-zero.
+   * @param quot Receives the quotient.
+   * @param rem Receives the remainder.
+   */
+  static void divmod_mag(const std::vector<limb_t>& dividend,
+                         const std::vector<limb_t>& divisor,
+                         std::vector<limb_t>& quot, std::vector<limb_t>& rem);
+
+  /**
+   * @brief Magnitude of this as limbs, regardless of storage form.
+   *
+   * @return little-endian base 2^32 magnitude.
+   */
+  std::vector<limb_t> magnitude() const;
+
+  /**
+   * @brief Rebuild this from a sign and a magnitude, demoting if it fits.
+   *
+   * @param neg Whether the value is negative.
+   * @param mag The magnitude.
+   */
+  void assign(bool neg, std::vector<limb_t>&& mag);
+
+ public:
+  /**
+   * @brief Construct zero.
+   *
+   */
+  bigint();
+
+  /**
+   * @brief Construct from a 64-bit value. Never allocates.
+   *
+   * @param value The value of the constructed integer.
+   */
+  bigint(std::int64_t value);  // NOLINT(runtime/explicit)
+
+  /**
+   * @brief Whether the value currently occupies the inline form.
+   *
+   * @return true when no heap limbs are in use.
+   */
+  bool is_small() const;
+
+  /**
+   * @brief Whether the value is zero.
+   *
+   * @return true when this == 0.
+   */
+  bool is_zero() const;
+
+  /**
+   * @brief Sign of the value.
+   *
+   * @return -1, 0, or 1.
+   */
+  int sign() const;
+
+  /**
+   * @brief Inline value. Only meaningful when is_small().
+   *
+   * @return the 64-bit value.
+   */
+  std::int64_t to_int64() const;
+
+  /**
+   * @brief Closest double approximation.
+   *
+   * @return double approximation of this.
+   */
+  double to_double() const;
+
+  /**
+   * @brief Flip the sign of this in place.
+   *
+   */
+  void negate();
+
+  /**
+   * @brief Add another integer.
+   *
+   * @param other The other integer.
+   * @return this
+   */
+  bigint& operator+=(const bigint& other);
+
+  /**
+   * @brief Subtract another integer.
+   *
+   * @param other The other integer.
+   * @return this
+   */
+  bigint& operator-=(const bigint& other);
+
+  /**
+   * @brief Multiply another integer.
+   *
+   * @param other The other integer.
+   * @return this
+   */
+  bigint& operator*=(const bigint& other);
+
+  /**
+   * @brief Truncated division and remainder.
+   *
+   * @param dividend The dividend.
+   * @param divisor The divisor. Must be non-zero.
+   * @param quot Receives the quotient, truncated toward zero.
+   * @param rem Receives the remainder, with the sign of the dividend.
+   */
+  static void divmod(const bigint& dividend, const bigint& divisor,
+                     bigint& quot, bigint& rem);
+
+  /**
+   * @brief Greatest common divisor of magnitudes.
+   *
+   * @param left The first integer.
+   * @param right The second integer.
+   * @return gcd(|left|, |right|).
+   */
+  static bigint gcd(const bigint& left, const bigint& right);
+
+  /**
+   * @brief Binary addition.
+   *
+   * @param left Left side integer.
+   * @param right Right side integer.
+   * @return operation on left and right.
+   */
+  friend bigint operator+(bigint left, const bigint& right);
+
+  /**
+   * @brief Binary subtraction.
+   *
+   * @param left Left side integer.
+   * @param right Right side integer.
+   * @return operation on left and right.
+   */
+  friend bigint operator-(bigint left, const bigint& right);
+
+  /**
+   * @brief Binary multiplication.
+   *
+   * @param left Left side integer.
+   * @param right Right side integer.
+   * @return operation on left and right.
+   */
+  friend bigint operator*(bigint left, const bigint& right);
+
+  /**
+   * @brief Binary truncated division.
+   *
+   * @param left Left side integer.
+   * @param right Right side integer.
+   * @return operation on left and right.
+   */
+  friend bigint operator/(const bigint& left, const bigint& right);
+
+  /**
+   * @brief Equality comparison.
+   *
+   * @param left Left side integer.
+   * @param right Right side integer.
+   * @return whether relation is satisfied.
+   */
+  friend bool operator==(const bigint& left, const bigint& right);
+
+  /**
+   * @brief Inequality comparison.
+   *
+   * @param left Left side integer.
+   * @param right Right side integer.
+   * @return whether relation is satisfied.
+   */
+  friend bool operator!=(const bigint& left, const bigint& right);
+
+  /**
+   * @brief Less than comparison.
+   *
+   * @param left Left side integer.
+   * @param right Right side integer.
+   * @return whether relation is satisfied.
+   */
+  friend bool operator<(const bigint& left, const bigint& right);
+
+  /**
+   * @brief Write integer to stream in decimal.
+   *
+   * @param out The output stream.
+   * @param value The integer to write.
+   * @return out
+   */
+  friend std::ostream& operator<<(std::ostream& out, const bigint& value);
+};
+
+/**
+ * @brief Exact rational with arbitrary-precision components.
+ *
+ * Mirrors the rational_t invariants: the denominator is always positive
+ * and the components are kept relatively prime. Components that fit in
+ * 64 bits stay inline in their bigint, so chains of small values run at
+ * near-fixed-width speed while overflowing products promote instead of
+ * wrapping.
+ */
+class big_rational {
+ private:
+  bigint num;
+  bigint denom;
+
+  /**
+   * @brief Reduces num and denom such that they are relatively prime.
+   *
+   */
+  void simplify();
+
+ public:
+  /**
+   * @brief Disallow no-arg default constructor.
+   *
+   */
+  big_rational() = delete;
+
+  /**
+   * @brief Construct a big rational given its integer value.
+   *
+   * @param value The value of the constructed rational.
+   */
+  explicit big_rational(std::int64_t value);
+
+  /**
+   * @brief Construct a big rational given numerator and denominator.
+   *
+   * @param numerator The numerator.
+   * @param denominator The denominator.
+   */
+  big_rational(bigint numerator, bigint denominator);
+
+  /**
+   * @brief Widen a fixed-width rational.
+   *
+   * @param frac The rational to widen.
+   */
+  explicit big_rational(const rational& frac);
+
+  /**
+   * @brief Numerator component. Relatively prime to denominator.
+   *
+   * @return numerator as a bigint.
+   */
+  const bigint& numerator() const;
+
+  /**
+   * @brief Denominator component. Relatively prime to numerator.
+   *
+   * @return denominator as a bigint.
+   */
+  const bigint& denominator() const;
+
+  /**
+   * @brief Get approximate value of the rational.
+   *
+   * @return double approximation of rational.
+   */
+  double value() const;
+
+  /**
+   * @brief Opposite sign of this.
+   *
+   * @return this reflected through 0
+   */
+  big_rational operator-() const;
+
+  /**
+   * @brief Add another rational.
+   *
+   * @param other The other rational.
+   * @return this
+   */
+  big_rational& operator+=(const big_rational& other);
+
+  /**
+   * @brief Binary addition.
+   *
+   * @param left Left side rational.
+   * @param right Right side rational.
+   * @return operation on left and right.
+   */
+  friend big_rational operator+(big_rational left, const big_rational& right);
+
+  /**
+   * @brief Subtract another rational.
+   *
+   * @param other The other rational.
+   * @return this
+   */
+  big_rational& operator-=(const big_rational& other);
+
+  /**
+   * @brief Binary subtraction.
+   *
+   * @param left Left side rational.
+   * @param right Right side rational.
+   * @return operation on left and right.
+   */
+  friend big_rational operator-(big_rational left, const big_rational& right);
+
+  /**
+   * @brief Multiply another rational.
+   *
+   * @param other The other rational.
+   * @return this
+   */
+  big_rational& operator*=(const big_rational& other);
+
+  /**
+   * @brief Binary multiplication.
+   *
+   * @param left Left side rational.
+   * @param right Right side rational.
+   * @return operation on left and right.
+   */
+  friend big_rational operator*(big_rational left, const big_rational& right);
+
+  /**
+   * @brief Divide another rational.
+   *
+   * @param other The other rational.
+   * @return this
+   */
+  big_rational& operator/=(const big_rational& other);
+
+  /**
+   * @brief Binary division.
+   *
+   * @param left Left side rational.
+   * @param right Right side rational.
+   * @return operation on left and right.
+   */
+  friend big_rational operator/(big_rational left, const big_rational& right);
+
+  /**
+   * @brief Equality comparison.
+   *
+   * @param left Left side rational.
+   * @param right Right side rational.
+   * @return whether relation is satisfied.
+   */
+  friend bool operator==(const big_rational& left, const big_rational& right);
+
+  /**
+   * @brief Inequality comparison.
+   *
+   * @param left Left side rational.
+   * @param right Right side rational.
+   * @return whether relation is satisfied.
+   */
+  friend bool operator!=(const big_rational& left, const big_rational& right);
+
+  /**
+   * @brief Less than comparison.
+   *
+   * @param left Left side rational.
+   * @param right Right side rational.
+   * @return whether relation is satisfied.
+   */
+  friend bool operator<(const big_rational& left, const big_rational& right);
+
+  /**
+   * @brief Less than or equal to comparison.
+   *
+   * @param left Left side rational.
+   * @param right Right side rational.
+   * @return whether relation is satisfied.
+   */
+  friend bool operator<=(const big_rational& left, const big_rational& right);
+
+  /**
+   * @brief Greater than comparison.
+   *
+   * @param left Left side rational.
+   * @param right Right side rational.
+   * @return whether relation is satisfied.
+   */
+  friend bool operator>(const big_rational& left, const big_rational& right);
+
+  /**
+   * @brief Greater than or equal to comparison.
+   *
+   * @param left Left side rational.
+   * @param right Right side rational.
+   * @return whether relation is satisfied.
+   */
+  friend bool operator>=(const big_rational& left, const big_rational& right);
+
+  /**
+   * @brief Write rational to stream.
+   *
+   * @param out The output stream.
+   * @param frac The rational to write.
+   * @return out
+   */
+  friend std::ostream& operator<<(std::ostream& out, const big_rational& frac);
+};
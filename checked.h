@@ -0,0 +1,310 @@
+/**
+ * @file checked.h
+ * @author Andrew Wang (siweiw9@gmail.com)
+ * @brief Overflow-checked rational arithmetic at near-unchecked speed.
+ * @version 0.1
+ * @date 2022-02-26
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+#include <cstdint>
+#include <stdexcept>
+
+#include "rational.h"
+
+/**
+ * @brief Rational whose operators detect component overflow.
+ *
+ * Wraps a canonical rational_t and runs the same two-gcd arithmetic
+ * through __builtin_add_overflow and __builtin_mul_overflow, so
+ * detection is a flag test after each product rather than a range check
+ * before it. The flag branch is never taken on in-range data, which the
+ * branch predictor learns, leaving the checked type within a few percent
+ * of the plain one. Actual overflow throws std::overflow_error with the
+ * operands still intact.
+ *
+ * @tparam T The integer type of the components.
+ */
+template <class T>
+class rational_checked {
+ public:
+  using integer_t = T;
+
+ private:
+  rational_t<T> frac;
+
+  /**
+   * @brief Checked product of two components.
+   *
+   * @param left The first factor.
+   * @param right The second factor.
+   * @return left * right.
+   */
+  static constexpr integer_t mul(integer_t left, integer_t right) {
+    integer_t out;
+    if (__builtin_mul_overflow(left, right, &out)) {
+      throw std::overflow_error("Rational component product overflows.");
+    }
+    return out;
+  }
+
+  /**
+   * @brief Checked sum of two components.
+   *
+   * @param left The first addend.
+   * @param right The second addend.
+   * @return left + right.
+   */
+  static constexpr integer_t add(integer_t left, integer_t right) {
+    integer_t out;
+    if (__builtin_add_overflow(left, right, &out)) {
+      throw std::overflow_error("Rational component sum overflows.");
+    }
+    return out;
+  }
+
+  /**
+   * @brief Greatest common divisor of two non-negative values.
+   *
+   * @param first The first integer.
+   * @param second The second integer.
+   * @return gcd(first, second)
+   */
+  static constexpr integer_t gcd_of(integer_t first, integer_t second) noexcept {
+    if (first < 0) first = static_cast<integer_t>(-first);
+    if (second < 0) second = static_cast<integer_t>(-second);
+    while (second != 0) {
+      const auto rem = static_cast<integer_t>(first % second);
+      first = second;
+      second = rem;
+    }
+    return first;
+  }
+
+  /**
+   * @brief Rebuild the wrapped rational from already-canonical parts.
+   *
+   * @param numerator The reduced numerator.
+   * @param denominator The reduced denominator. Must be positive.
+   */
+  constexpr void assign(integer_t numerator, integer_t denominator) noexcept {
+    frac = rational_t<T>(rational_t<T>::unreduced, numerator, denominator);
+  }
+
+ public:
+  /**
+   * @brief Construct a checked rational equivalent to an integer.
+   *
+   * @param value The integer value. Defaults to 0.
+   */
+  constexpr rational_checked(integer_t value = 0) noexcept  // NOLINT
+      : frac(value) {}
+
+  /**
+   * @brief Construct a checked rational from a numerator and denominator.
+   *
+   * @param numerator The numerator.
+   * @param denominator The denominator. Must be non-zero.
+   */
+  constexpr rational_checked(integer_t numerator, integer_t denominator)
+      : frac(numerator, denominator) {}
+
+  /**
+   * @brief Wrap an existing rational.
+   *
+   * @param value The wrapped rational.
+   */
+  constexpr rational_checked(const rational_t<T>& value) noexcept  // NOLINT
+      : frac(value) {}
+
+  /**
+   * @brief The wrapped canonical rational.
+   *
+   * @return the value.
+   */
+  constexpr const rational_t<T>& value() const noexcept { return frac; }
+
+  /**
+   * @brief The numerator of the wrapped rational.
+   *
+   * @return the numerator.
+   */
+  constexpr integer_t numerator() const noexcept { return frac.numerator(); }
+
+  /**
+   * @brief The denominator of the wrapped rational.
+   *
+   * @return the denominator.
+   */
+  constexpr integer_t denominator() const noexcept {
+    return frac.denominator();
+  }
+
+  /**
+   * @brief Checked addition. Knuth's two-gcd scheme with flag tests.
+   *
+   * @param other The added rational.
+   * @return this
+   */
+  constexpr rational_checked& operator+=(const rational_checked& other) {
+    const auto o_num = other.frac.numerator();
+    const auto o_denom = other.frac.denominator();
+    const auto g1 = gcd_of(frac.denominator(), o_denom);
+    if (g1 == 1) {
+      assign(add(mul(frac.numerator(), o_denom), mul(frac.denominator(), o_num)),
+             mul(frac.denominator(), o_denom));
+    } else {
+      const auto t =
+          add(mul(frac.numerator(), static_cast<integer_t>(o_denom / g1)),
+              mul(o_num, static_cast<integer_t>(frac.denominator() / g1)));
+      const auto g2 = gcd_of(t, g1);
+      assign(static_cast<integer_t>(t / g2),
+             mul(static_cast<integer_t>(frac.denominator() / g1),
+                 static_cast<integer_t>(o_denom / g2)));
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Checked subtraction.
+   *
+   * @param other The subtracted rational.
+   * @return this
+   */
+  constexpr rational_checked& operator-=(const rational_checked& other) {
+    integer_t neg;
+    if (__builtin_sub_overflow(integer_t(0), other.frac.numerator(), &neg)) {
+      throw std::overflow_error("Rational component sum overflows.");
+    }
+    return *this += rational_checked(
+               rational_t<T>(rational_t<T>::unreduced, neg,
+                             other.frac.denominator()));
+  }
+
+  /**
+   * @brief Checked multiplication with cross-reduction.
+   *
+   * Reducing each numerator against the opposite denominator first keeps
+   * the checked products as small as the canonical result allows.
+   *
+   * @param other The multiplied rational.
+   * @return this
+   */
+  constexpr rational_checked& operator*=(const rational_checked& other) {
+    const auto g1 = gcd_of(frac.numerator(), other.frac.denominator());
+    const auto g2 = gcd_of(other.frac.numerator(), frac.denominator());
+    assign(mul(static_cast<integer_t>(frac.numerator() / g1),
+               static_cast<integer_t>(other.frac.numerator() / g2)),
+           mul(static_cast<integer_t>(frac.denominator() / g2),
+               static_cast<integer_t>(other.frac.denominator() / g1)));
+    return *this;
+  }
+
+  /**
+   * @brief Checked division.
+   *
+   * @param other The divisor. Must be non-zero.
+   * @return this
+   */
+  constexpr rational_checked& operator/=(const rational_checked& other) {
+    if (other.frac.numerator() == 0) {
+      throw std::invalid_argument("Cannot divide by zero.");
+    }
+    auto flipped = other.frac.numerator() < 0
+                       ? rational_t<T>(rational_t<T>::unreduced,
+                                       static_cast<integer_t>(
+                                           -other.frac.denominator()),
+                                       static_cast<integer_t>(
+                                           -other.frac.numerator()))
+                       : rational_t<T>(rational_t<T>::unreduced,
+                                       other.frac.denominator(),
+                                       other.frac.numerator());
+    return *this *= rational_checked(flipped);
+  }
+
+  /**
+   * @brief Checked addition.
+   *
+   * @param left Left side rational.
+   * @param right Right side rational.
+   * @return left + right
+   */
+  friend constexpr rational_checked operator+(rational_checked left,
+                                              const rational_checked& right) {
+    return left += right;
+  }
+
+  /**
+   * @brief Checked subtraction.
+   *
+   * @param left Left side rational.
+   * @param right Right side rational.
+   * @return left - right
+   */
+  friend constexpr rational_checked operator-(rational_checked left,
+                                              const rational_checked& right) {
+    return left -= right;
+  }
+
+  /**
+   * @brief Checked multiplication.
+   *
+   * @param left Left side rational.
+   * @param right Right side rational.
+   * @return left * right
+   */
+  friend constexpr rational_checked operator*(rational_checked left,
+                                              const rational_checked& right) {
+    return left *= right;
+  }
+
+  /**
+   * @brief Checked division.
+   *
+   * @param left Left side rational.
+   * @param right Right side rational. Must be non-zero.
+   * @return left / right
+   */
+  friend constexpr rational_checked operator/(rational_checked left,
+                                              const rational_checked& right) {
+    return left /= right;
+  }
+
+  /**
+   * @brief Exact equality of the wrapped values.
+   *
+   * @param left Left side rational.
+   * @param right Right side rational.
+   * @return whether left == right.
+   */
+  friend constexpr bool operator==(const rational_checked& left,
+                                   const rational_checked& right) noexcept {
+    return left.frac == right.frac;
+  }
+
+  /**
+   * @brief Exact inequality of the wrapped values.
+   *
+   * @param left Left side rational.
+   * @param right Right side rational.
+   * @return whether left != right.
+   */
+  friend constexpr bool operator!=(const rational_checked& left,
+                                   const rational_checked& right) noexcept {
+    return left.frac != right.frac;
+  }
+
+  /**
+   * @brief Exact ordering of the wrapped values.
+   *
+   * @param left Left side rational.
+   * @param right Right side rational.
+   * @return whether left < right.
+   */
+  friend constexpr bool operator<(const rational_checked& left,
+                                  const rational_checked& right) noexcept {
+    return left.frac < right.frac;
+  }
+};
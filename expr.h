@@ -0,0 +1,276 @@
+/**
+ * @file expr.h
+ * @author Andrew Wang (siweiw9@gmail.com)
+ * @brief Expression fusion for compound rational arithmetic.
+ * @version 0.1
+ * @date 2022-02-26
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#include "rational.h"
+
+/**
+ * @brief Unreduced expression value in doubled-width components.
+ *
+ * Wrapping one operand with expr() switches a compound expression like
+ * expr(a) * b + c * d onto this type: every intermediate combines raw
+ * cross-multiplied components in a wider integer with no gcd and no
+ * temporary rational, and the single reduction runs at the terminal
+ * eval(). Cuts the three gcd-plus-division rounds of a three-operator
+ * chain to one.
+ *
+ * Components up to 64 bits widen (int64 for rational32, __int128 for
+ * rational); the widest component type stays at its own width and gets
+ * fusion without extra headroom.
+ *
+ * @tparam T The integer type of the terminal rational's components.
+ */
+template <class T>
+class rational_expr {
+ public:
+#ifdef __SIZEOF_INT128__
+  using wide_t =
+      std::conditional_t<sizeof(T) <= 4, std::int64_t,
+                         std::conditional_t<sizeof(T) <= 8, int128_t, T>>;
+#else
+  using wide_t = std::conditional_t<sizeof(T) <= 4, std::int64_t, T>;
+#endif
+
+ private:
+  wide_t num;
+  wide_t denom;
+
+  /**
+   * @brief Wrap raw wide components. Internal node constructor.
+   *
+   * @param numerator The unreduced numerator.
+   * @param denominator The unreduced denominator.
+   */
+  constexpr rational_expr(wide_t numerator, wide_t denominator) noexcept
+      : num(numerator), denom(denominator) {}
+
+  /**
+   * @brief Greatest common divisor over the wide type.
+   *
+   * @param first The first integer.
+   * @param second The second integer.
+   * @return gcd(first, second)
+   */
+  static constexpr wide_t gcd_of(wide_t first, wide_t second) noexcept {
+    if (first < 0) first = -first;
+    if (second < 0) second = -second;
+    while (second != 0) {
+      const auto rem = first % second;
+      first = second;
+      second = rem;
+    }
+    return first;
+  }
+
+ public:
+  /**
+   * @brief Lift a rational into the expression domain.
+   *
+   * @param frac The leaf operand.
+   */
+  explicit constexpr rational_expr(const rational_t<T>& frac) noexcept
+      : num(frac.numerator()), denom(frac.denominator()) {}
+
+  /**
+   * @brief Reduce once and narrow back to the component type.
+   *
+   * @return canonical rational value of the expression.
+   */
+  constexpr rational_t<T> eval() const {
+    auto n = num;
+    auto d = denom;
+    if (d < 0) {
+      n = -n;
+      d = -d;
+    }
+    const auto div = gcd_of(n, d);
+    if (div != 0) {
+      n /= div;
+      d /= div;
+    }
+    constexpr auto int_max =
+        static_cast<wide_t>(~(static_cast<T>(1) << (8 * sizeof(T) - 1)));
+    if (n > int_max || n < -int_max || d > int_max) {
+      throw std::overflow_error("Expression value exceeds component range.");
+    }
+    return rational_t<T>(rational_t<T>::unreduced, static_cast<T>(n),
+                         static_cast<T>(d));
+  }
+
+  /**
+   * @brief Terminal conversion back to a rational. Runs eval().
+   *
+   */
+  constexpr operator rational_t<T>() const { return eval(); }  // NOLINT
+
+  /**
+   * @brief Fused addition.
+   *
+   * @param left Left side expression.
+   * @param right Right side expression.
+   * @return unreduced expression for left + right.
+   */
+  friend constexpr rational_expr operator+(const rational_expr& left,
+                                           const rational_expr& right) noexcept {
+    return rational_expr(left.num * right.denom + left.denom * right.num,
+                         left.denom * right.denom);
+  }
+
+  /**
+   * @brief Fused subtraction.
+   *
+   * @param left Left side expression.
+   * @param right Right side expression.
+   * @return unreduced expression for left - right.
+   */
+  friend constexpr rational_expr operator-(const rational_expr& left,
+                                           const rational_expr& right) noexcept {
+    return rational_expr(left.num * right.denom - left.denom * right.num,
+                         left.denom * right.denom);
+  }
+
+  /**
+   * @brief Fused multiplication.
+   *
+   * @param left Left side expression.
+   * @param right Right side expression.
+   * @return unreduced expression for left * right.
+   */
+  friend constexpr rational_expr operator*(const rational_expr& left,
+                                           const rational_expr& right) noexcept {
+    return rational_expr(left.num * right.num, left.denom * right.denom);
+  }
+
+  /**
+   * @brief Fused division.
+   *
+   * @param left Left side expression.
+   * @param right Right side expression.
+   * @return unreduced expression for left / right.
+   */
+  friend constexpr rational_expr operator/(const rational_expr& left,
+                                           const rational_expr& right) {
+    if (right.num == 0) {
+      throw std::invalid_argument("Cannot divide by zero.");
+    }
+    return rational_expr(left.num * right.denom, left.denom * right.num);
+  }
+
+  /**
+   * @brief Fused addition with a plain rational operand.
+   *
+   * @param left Left side expression.
+   * @param right Right side rational.
+   * @return unreduced expression for left + right.
+   */
+  friend constexpr rational_expr operator+(const rational_expr& left,
+                                           const rational_t<T>& right) noexcept {
+    return left + rational_expr(right);
+  }
+
+  /**
+   * @brief Fused addition with a plain rational operand.
+   *
+   * @param left Left side rational.
+   * @param right Right side expression.
+   * @return unreduced expression for left + right.
+   */
+  friend constexpr rational_expr operator+(const rational_t<T>& left,
+                                           const rational_expr& right) noexcept {
+    return rational_expr(left) + right;
+  }
+
+  /**
+   * @brief Fused subtraction with a plain rational operand.
+   *
+   * @param left Left side expression.
+   * @param right Right side rational.
+   * @return unreduced expression for left - right.
+   */
+  friend constexpr rational_expr operator-(const rational_expr& left,
+                                           const rational_t<T>& right) noexcept {
+    return left - rational_expr(right);
+  }
+
+  /**
+   * @brief Fused subtraction with a plain rational operand.
+   *
+   * @param left Left side rational.
+   * @param right Right side expression.
+   * @return unreduced expression for left - right.
+   */
+  friend constexpr rational_expr operator-(const rational_t<T>& left,
+                                           const rational_expr& right) noexcept {
+    return rational_expr(left) - right;
+  }
+
+  /**
+   * @brief Fused multiplication with a plain rational operand.
+   *
+   * @param left Left side expression.
+   * @param right Right side rational.
+   * @return unreduced expression for left * right.
+   */
+  friend constexpr rational_expr operator*(const rational_expr& left,
+                                           const rational_t<T>& right) noexcept {
+    return left * rational_expr(right);
+  }
+
+  /**
+   * @brief Fused multiplication with a plain rational operand.
+   *
+   * @param left Left side rational.
+   * @param right Right side expression.
+   * @return unreduced expression for left * right.
+   */
+  friend constexpr rational_expr operator*(const rational_t<T>& left,
+                                           const rational_expr& right) noexcept {
+    return rational_expr(left) * right;
+  }
+
+  /**
+   * @brief Fused division with a plain rational operand.
+   *
+   * @param left Left side expression.
+   * @param right Right side rational.
+   * @return unreduced expression for left / right.
+   */
+  friend constexpr rational_expr operator/(const rational_expr& left,
+                                           const rational_t<T>& right) {
+    return left / rational_expr(right);
+  }
+
+  /**
+   * @brief Fused division with a plain rational operand.
+   *
+   * @param left Left side rational.
+   * @param right Right side expression.
+   * @return unreduced expression for left / right.
+   */
+  friend constexpr rational_expr operator/(const rational_t<T>& left,
+                                           const rational_expr& right) {
+    return rational_expr(left) / right;
+  }
+};
+
+/**
+ * @brief Lift a rational into the expression domain.
+ *
+ * @param frac The leaf operand.
+ * @return expression wrapping frac.
+ */
+template <class T>
+constexpr rational_expr<T> expr(const rational_t<T>& frac) noexcept {
+  return rational_expr<T>(frac);
+}
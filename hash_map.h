@@ -0,0 +1,155 @@
+/**
+ * @file hash_map.h
+ * @author Andrew Wang (siweiw9@gmail.com)
+ * @brief Open-addressed hash map keyed by exact rational values.
+ * @version 0.1
+ * @date 2022-02-26
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "rational.h"
+
+/**
+ * @brief Open-addressed map from rationals to values.
+ *
+ * Building block for memo tables: linear probing over a flat
+ * power-of-two slot array, so a lookup is one hash, one mask, and a
+ * short contiguous scan with no per-node allocation or pointer chasing.
+ * Insert-only by design; use clear() to recycle a table.
+ *
+ * @tparam T The integer type of the rational keys' components.
+ * @tparam V The mapped value type. Must be default-constructible.
+ */
+template <class T, class V>
+class rational_map {
+ public:
+  using key_t = rational_t<T>;
+
+ private:
+  /**
+   * @brief One probe slot: a key, its value, and an occupancy flag.
+   *
+   */
+  struct slot {
+    key_t key{0};
+    V value{};
+    bool full = false;
+  };
+
+  std::vector<slot> slots;
+  std::size_t count;
+
+  /**
+   * @brief Index of the slot holding key, or of the empty slot where it
+   * would be inserted.
+   *
+   * @param key The key to probe for.
+   * @return slot index.
+   */
+  std::size_t probe(const key_t& key) const {
+    const auto mask = slots.size() - 1;
+    auto index = key.hash_code() & mask;
+    while (slots[index].full && slots[index].key != key) {
+      index = (index + 1) & mask;
+    }
+    return index;
+  }
+
+  /**
+   * @brief Double the slot array and rehash every occupied slot.
+   *
+   */
+  void grow() {
+    std::vector<slot> old(slots.size() * 2);
+    old.swap(slots);
+    for (auto& occupied : old) {
+      if (!occupied.full) continue;
+      slots[probe(occupied.key)] = std::move(occupied);
+    }
+  }
+
+ public:
+  /**
+   * @brief Construct an empty map.
+   *
+   */
+  rational_map() : slots(16), count(0) {}
+
+  /**
+   * @brief Number of keys held.
+   *
+   * @return key count.
+   */
+  std::size_t size() const { return count; }
+
+  /**
+   * @brief Whether the map holds no keys.
+   *
+   * @return true when empty.
+   */
+  bool empty() const { return count == 0; }
+
+  /**
+   * @brief Value mapped to key, inserting a default value if absent.
+   *
+   * Grows the slot array at 70% load to keep probe chains short.
+   *
+   * @param key The lookup key.
+   * @return reference to the mapped value.
+   */
+  V& operator[](const key_t& key) {
+    if (10 * (count + 1) >= 7 * slots.size()) grow();
+    const auto index = probe(key);
+    if (!slots[index].full) {
+      slots[index].key = key;
+      slots[index].full = true;
+      ++count;
+    }
+    return slots[index].value;
+  }
+
+  /**
+   * @brief Look up a key without inserting.
+   *
+   * @param key The lookup key.
+   * @return pointer to the mapped value, or nullptr if absent.
+   */
+  const V* find(const key_t& key) const {
+    const auto index = probe(key);
+    return slots[index].full ? &slots[index].value : nullptr;
+  }
+
+  /**
+   * @brief Look up a key without inserting.
+   *
+   * @param key The lookup key.
+   * @return pointer to the mapped value, or nullptr if absent.
+   */
+  V* find(const key_t& key) {
+    const auto index = probe(key);
+    return slots[index].full ? &slots[index].value : nullptr;
+  }
+
+  /**
+   * @brief Whether the map holds the key.
+   *
+   * @param key The lookup key.
+   * @return true when present.
+   */
+  bool contains(const key_t& key) const { return find(key) != nullptr; }
+
+  /**
+   * @brief Remove every key, keeping the slot array capacity.
+   *
+   */
+  void clear() {
+    for (auto& occupied : slots) occupied.full = false;
+    count = 0;
+  }
+};
@@ -0,0 +1,134 @@
+/**
+ * @file intern.h
+ * @author Andrew Wang (siweiw9@gmail.com)
+ * @brief Four-byte flyweight handles for small common rationals.
+ * @version 0.1
+ * @date 2022-02-26
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+#include <cstdint>
+#include <stdexcept>
+
+#include "rational.h"
+
+/**
+ * @brief Compact handle for a rational with small components.
+ *
+ * Columns dominated by values like 0, 1, and 1/2 waste most of their 16
+ * bytes per element. This handle packs the canonical components into an
+ * int16 numerator and uint16 denominator — four bytes, a quarter of
+ * rational64 — and converts to and from the full type transparently.
+ * Canonical components make the packing its own intern table: equal
+ * values pack to identical bits, so handle equality is one integer
+ * compare with no cross-multiply.
+ *
+ * @tparam T The integer type of the widened rational's components.
+ */
+template <class T = std::int64_t>
+class rational_interned {
+ private:
+  std::int16_t num;
+  std::uint16_t denom;
+
+ public:
+  /**
+   * @brief Largest component magnitude a handle can hold.
+   *
+   */
+  static constexpr std::int64_t max_component = 32767;
+
+  /**
+   * @brief Whether a rational is small enough to intern.
+   *
+   * @param frac The candidate rational.
+   * @return true when every component fits the packed fields.
+   */
+  static constexpr bool fits(const rational_t<T>& frac) noexcept {
+    return frac.numerator() <= max_component &&
+           frac.numerator() >= -max_component &&
+           frac.denominator() <= max_component;
+  }
+
+  /**
+   * @brief Intern the value zero.
+   *
+   */
+  constexpr rational_interned() noexcept : num(0), denom(1) {}
+
+  /**
+   * @brief Intern a rational with small components.
+   *
+   * @param frac The interned rational. Every component must fit.
+   */
+  constexpr rational_interned(const rational_t<T>& frac)  // NOLINT
+      : num(0), denom(1) {
+    if (!fits(frac)) {
+      throw std::invalid_argument("Rational is too large to intern.");
+    }
+    num = static_cast<std::int16_t>(frac.numerator());
+    denom = static_cast<std::uint16_t>(frac.denominator());
+  }
+
+  /**
+   * @brief Widen back to a full rational.
+   *
+   * @return the interned value.
+   */
+  constexpr operator rational_t<T>() const noexcept {  // NOLINT
+    return rational_t<T>(rational_t<T>::unreduced, static_cast<T>(num),
+                         static_cast<T>(denom));
+  }
+
+  /**
+   * @brief The numerator of the interned value.
+   *
+   * @return the numerator.
+   */
+  constexpr T numerator() const noexcept { return static_cast<T>(num); }
+
+  /**
+   * @brief The denominator of the interned value.
+   *
+   * @return the denominator.
+   */
+  constexpr T denominator() const noexcept { return static_cast<T>(denom); }
+
+  /**
+   * @brief Exact equality by bit pattern. No cross-multiply.
+   *
+   * @param left Left side handle.
+   * @param right Right side handle.
+   * @return whether both hold the same value.
+   */
+  friend constexpr bool operator==(const rational_interned& left,
+                                   const rational_interned& right) noexcept {
+    return left.num == right.num && left.denom == right.denom;
+  }
+
+  /**
+   * @brief Exact inequality by bit pattern.
+   *
+   * @param left Left side handle.
+   * @param right Right side handle.
+   * @return whether the handles hold different values.
+   */
+  friend constexpr bool operator!=(const rational_interned& left,
+                                   const rational_interned& right) noexcept {
+    return !(left == right);
+  }
+
+  /**
+   * @brief Exact ordering through the widened values.
+   *
+   * @param left Left side handle.
+   * @param right Right side handle.
+   * @return whether left < right.
+   */
+  friend constexpr bool operator<(const rational_interned& left,
+                                  const rational_interned& right) noexcept {
+    return rational_t<T>(left) < rational_t<T>(right);
+  }
+};
@@ -0,0 +1,236 @@
+/**
+ * @file linalg.h
+ * @author Andrew Wang (siweiw9@gmail.com)
+ * @brief Exact rational linear algebra over fraction-free elimination.
+ * @version 0.1
+ * @date 2022-02-26
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "rational.h"
+
+/**
+ * @brief Dense rational matrices with Bareiss elimination.
+ *
+ * Naive Gaussian elimination over rationals compounds a gcd into every
+ * multiply and lets entry sizes explode. The kernels here instead clear
+ * each row to integers once, run Bareiss fraction-free elimination —
+ * whose divisions are exact and whose intermediates stay minors of the
+ * input, provably small — and return to rationals only at the end, so
+ * the whole pivot step costs one division per entry and no gcd at all.
+ */
+namespace linalg {
+
+/**
+ * @brief Dense row-major matrix of rationals.
+ *
+ * @tparam T The integer type of the entries' components.
+ */
+template <class T>
+class matrix {
+ private:
+  std::size_t row_count;
+  std::size_t col_count;
+  std::vector<rational_t<T>> cells;
+
+ public:
+  /**
+   * @brief Construct a zero matrix of the given shape.
+   *
+   * @param rows Number of rows. Must be positive.
+   * @param cols Number of columns. Must be positive.
+   */
+  matrix(std::size_t rows, std::size_t cols)
+      : row_count(rows), col_count(cols), cells(rows * cols, rational_t<T>(0)) {
+    if (rows == 0 || cols == 0) {
+      throw std::invalid_argument("Matrix shape must be positive.");
+    }
+  }
+
+  /**
+   * @brief Number of rows.
+   *
+   * @return row count.
+   */
+  std::size_t rows() const noexcept { return row_count; }
+
+  /**
+   * @brief Number of columns.
+   *
+   * @return column count.
+   */
+  std::size_t cols() const noexcept { return col_count; }
+
+  /**
+   * @brief Entry at the given position. Unchecked.
+   *
+   * @param row The row index.
+   * @param col The column index.
+   * @return reference to the entry.
+   */
+  rational_t<T>& operator()(std::size_t row, std::size_t col) {
+    return cells[row * col_count + col];
+  }
+
+  /**
+   * @brief Entry at the given position. Unchecked.
+   *
+   * @param row The row index.
+   * @param col The column index.
+   * @return the entry.
+   */
+  const rational_t<T>& operator()(std::size_t row, std::size_t col) const {
+    return cells[row * col_count + col];
+  }
+};
+
+/**
+ * @brief Integer working copy of a rational matrix, one row at a time.
+ *
+ * Each row scales by the least common multiple of its denominators, so
+ * elimination runs on plain integers; scales records the per-row factor
+ * for undoing the scaling in determinants.
+ *
+ * @param source The rational matrix. May be augmented.
+ * @param scales Receives one positive factor per row.
+ * @return row-major integer entries.
+ */
+template <class T>
+std::vector<T> integerize(const matrix<T>& source, std::vector<T>& scales) {
+  const auto rows = source.rows();
+  const auto cols = source.cols();
+  std::vector<T> work(rows * cols);
+  scales.assign(rows, T(1));
+  for (std::size_t row = 0; row < rows; ++row) {
+    auto common = T(1);
+    for (std::size_t col = 0; col < cols; ++col) {
+      const auto denom = source(row, col).denominator();
+      const auto reduced = rational_t<T>(common, denom).denominator();
+      common = static_cast<T>(common * reduced);
+    }
+    scales[row] = common;
+    for (std::size_t col = 0; col < cols; ++col) {
+      const auto& entry = source(row, col);
+      work[row * cols + col] = static_cast<T>(
+          entry.numerator() * (common / entry.denominator()));
+    }
+  }
+  return work;
+}
+
+/**
+ * @brief Bareiss fraction-free elimination in place.
+ *
+ * After step k every entry below and right of the pivot is a (k+2)-minor
+ * of the input, and the division by the previous pivot is exact — no
+ * fractions appear and no gcd runs.
+ *
+ * @param work Row-major integer entries, modified in place.
+ * @param rows Number of rows.
+ * @param cols Number of columns. At least rows.
+ * @return the sign flip from row swaps, or 0 if a pivot column was zero.
+ */
+template <class T>
+int eliminate(std::vector<T>& work, std::size_t rows, std::size_t cols) {
+  int sign = 1;
+  auto prev = T(1);
+  for (std::size_t k = 0; k < rows; ++k) {
+    if (work[k * cols + k] == 0) {
+      std::size_t swap = k + 1;
+      while (swap < rows && work[swap * cols + k] == 0) ++swap;
+      if (swap == rows) return 0;
+      for (std::size_t col = 0; col < cols; ++col) {
+        const auto held = work[k * cols + col];
+        work[k * cols + col] = work[swap * cols + col];
+        work[swap * cols + col] = held;
+      }
+      sign = -sign;
+    }
+    const auto pivot = work[k * cols + k];
+    for (std::size_t row = k + 1; row < rows; ++row) {
+      const auto factor = work[row * cols + k];
+      for (std::size_t col = k + 1; col < cols; ++col) {
+        work[row * cols + col] = static_cast<T>(
+            (pivot * work[row * cols + col] - factor * work[k * cols + col]) /
+            prev);
+      }
+      work[row * cols + k] = 0;
+    }
+    prev = pivot;
+  }
+  return sign;
+}
+
+/**
+ * @brief Exact determinant by Bareiss elimination.
+ *
+ * @param source The matrix. Must be square.
+ * @return the determinant.
+ */
+template <class T>
+rational_t<T> determinant(const matrix<T>& source) {
+  if (source.rows() != source.cols()) {
+    throw std::invalid_argument("Determinant requires a square matrix.");
+  }
+  const auto order = source.rows();
+  std::vector<T> scales;
+  auto work = integerize(source, scales);
+  const auto sign = eliminate(work, order, order);
+  if (sign == 0) return rational_t<T>(0);
+  auto result = rational_t<T>(work[(order - 1) * order + (order - 1)]);
+  if (sign < 0) result = -result;
+  for (const auto scale : scales) result /= rational_t<T>(scale);
+  return result;
+}
+
+/**
+ * @brief Exact solution of a square linear system.
+ *
+ * Eliminates the augmented matrix fraction-free, then back-substitutes
+ * in rationals over the already-triangular integer entries.
+ *
+ * @param lhs The coefficient matrix. Must be square and non-singular.
+ * @param rhs The right-hand side. Must match the matrix order.
+ * @return the unique solution vector.
+ */
+template <class T>
+std::vector<rational_t<T>> solve(const matrix<T>& lhs,
+                                 const std::vector<rational_t<T>>& rhs) {
+  if (lhs.rows() != lhs.cols()) {
+    throw std::invalid_argument("Solve requires a square matrix.");
+  }
+  const auto order = lhs.rows();
+  if (rhs.size() != order) {
+    throw std::invalid_argument("Right-hand side length must match.");
+  }
+  matrix<T> augmented(order, order + 1);
+  for (std::size_t row = 0; row < order; ++row) {
+    for (std::size_t col = 0; col < order; ++col) {
+      augmented(row, col) = lhs(row, col);
+    }
+    augmented(row, order) = rhs[row];
+  }
+  std::vector<T> scales;
+  auto work = integerize(augmented, scales);
+  if (eliminate(work, order, order + 1) == 0) {
+    throw std::invalid_argument("Matrix is singular.");
+  }
+  std::vector<rational_t<T>> solution(order, rational_t<T>(0));
+  for (std::size_t step = order; step > 0; --step) {
+    const auto row = step - 1;
+    auto accum = rational_t<T>(work[row * (order + 1) + order]);
+    for (std::size_t col = row + 1; col < order; ++col) {
+      accum -= rational_t<T>(work[row * (order + 1) + col]) * solution[col];
+    }
+    solution[row] = accum / rational_t<T>(work[row * (order + 1) + row]);
+  }
+  return solution;
+}
+
+}  // namespace linalg
@@ -0,0 +1,166 @@
+/**
+ * @file parallel.h
+ * @author Andrew Wang (siweiw9@gmail.com)
+ * @brief Load-balanced parallel bulk transforms over rational ranges.
+ * @version 0.1
+ * @date 2022-02-26
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#include "rational.h"
+
+/**
+ * @brief Dynamically scheduled bulk operations.
+ *
+ * Rational ops have data-dependent cost — gcd time grows with component
+ * size — so static partitioning strands threads behind whichever block
+ * drew the large components. Workers here instead claim small chunks
+ * from one shared atomic counter: a thread that finishes early simply
+ * claims the work a slow thread has not reached, which balances skewed
+ * data the way stealing from per-thread deques would at far less
+ * machinery. Chunks are sized down when sampled components are large, so
+ * expensive regions split finer.
+ */
+namespace parallel {
+
+/**
+ * @brief Chunk size for cheap, small-component data.
+ *
+ */
+constexpr std::size_t max_chunk = 1024;
+
+/**
+ * @brief Chunk size where sampled components are large and ops are slow.
+ *
+ */
+constexpr std::size_t min_chunk = 128;
+
+/**
+ * @brief Pick a chunk size from a sample of the range's components.
+ *
+ * Components past the half-width bound make every gcd and cross-multiply
+ * slower and more variable, so such ranges split into finer chunks.
+ *
+ * @param first Start of the range.
+ * @param count Number of elements.
+ * @return records per claimed chunk.
+ */
+template <class Iter>
+std::size_t pick_chunk(Iter first, std::size_t count) {
+  using rational_v = typename std::iterator_traits<Iter>::value_type;
+  constexpr auto bound = static_cast<typename rational_v::integer_t>(
+      static_cast<typename rational_v::integer_t>(1)
+      << ((8 * sizeof(typename rational_v::integer_t) - 1) / 2));
+  const auto samples = std::min<std::size_t>(count, 64);
+  std::size_t heavy = 0;
+  for (std::size_t i = 0; i < samples; ++i) {
+    // Spread the samples over [0, count - 1] so the last one lands on
+    // the final element instead of past it.
+    const auto index = samples > 1 ? i * (count - 1) / (samples - 1) : 0;
+    const auto& sample = first[static_cast<std::ptrdiff_t>(index)];
+    if (sample.denominator() >= bound || sample.numerator() >= bound ||
+        sample.numerator() <= -bound) {
+      ++heavy;
+    }
+  }
+  return 4 * heavy >= samples ? min_chunk : max_chunk;
+}
+
+/**
+ * @brief Apply a function to every element, dynamically scheduled.
+ *
+ * @param first Start of the range.
+ * @param last One past the end of the range.
+ * @param func Callable applied to each element by reference.
+ * @param nthreads Worker count; zero picks the hardware concurrency.
+ */
+template <class Iter, class Func>
+void for_each(Iter first, Iter last, Func func, unsigned nthreads = 0) {
+  const auto count = static_cast<std::size_t>(std::distance(first, last));
+  if (count == 0) return;
+  if (nthreads == 0) {
+    nthreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  const auto chunk = pick_chunk(first, count);
+  const auto chunks = (count + chunk - 1) / chunk;
+  const auto workers =
+      std::min<std::size_t>(nthreads, std::max<std::size_t>(chunks, 1));
+  if (workers < 2) {
+    for (auto it = first; it != last; ++it) func(*it);
+    return;
+  }
+  std::atomic<std::size_t> next(0);
+  std::vector<std::thread> pool;
+  pool.reserve(workers);
+  for (std::size_t worker = 0; worker < workers; ++worker) {
+    pool.emplace_back([first, count, chunk, chunks, &next, &func]() {
+      for (auto claimed = next.fetch_add(1); claimed < chunks;
+           claimed = next.fetch_add(1)) {
+        const auto begin = claimed * chunk;
+        const auto end = std::min(begin + chunk, count);
+        for (auto i = begin; i < end; ++i) {
+          func(first[static_cast<std::ptrdiff_t>(i)]);
+        }
+      }
+    });
+  }
+  for (auto& thread : pool) thread.join();
+}
+
+/**
+ * @brief Map a range into an output range, dynamically scheduled.
+ *
+ * @param first Start of the input range.
+ * @param last One past the end of the input range.
+ * @param out Start of the output range. Must not overlap the input.
+ * @param func Callable mapping an element to its output value.
+ * @param nthreads Worker count; zero picks the hardware concurrency.
+ */
+template <class Iter, class OutIter, class Func>
+void transform(Iter first, Iter last, OutIter out, Func func,
+               unsigned nthreads = 0) {
+  const auto count = static_cast<std::size_t>(std::distance(first, last));
+  if (count == 0) return;
+  if (nthreads == 0) {
+    nthreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  const auto chunk = pick_chunk(first, count);
+  const auto chunks = (count + chunk - 1) / chunk;
+  const auto workers =
+      std::min<std::size_t>(nthreads, std::max<std::size_t>(chunks, 1));
+  if (workers < 2) {
+    for (std::size_t i = 0; i < count; ++i) {
+      out[static_cast<std::ptrdiff_t>(i)] =
+          func(first[static_cast<std::ptrdiff_t>(i)]);
+    }
+    return;
+  }
+  std::atomic<std::size_t> next(0);
+  std::vector<std::thread> pool;
+  pool.reserve(workers);
+  for (std::size_t worker = 0; worker < workers; ++worker) {
+    pool.emplace_back([first, out, count, chunk, chunks, &next, &func]() {
+      for (auto claimed = next.fetch_add(1); claimed < chunks;
+           claimed = next.fetch_add(1)) {
+        const auto begin = claimed * chunk;
+        const auto end = std::min(begin + chunk, count);
+        for (auto i = begin; i < end; ++i) {
+          out[static_cast<std::ptrdiff_t>(i)] =
+              func(first[static_cast<std::ptrdiff_t>(i)]);
+        }
+      }
+    });
+  }
+  for (auto& thread : pool) thread.join();
+}
+
+}  // namespace parallel
@@ -9,41 +9,442 @@
  *
  */
 #pragma once
+#include <charconv>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifdef __SIZEOF_INT128__
+/**
+ * @brief Signed 128-bit integer for overflow-prone workloads.
+ *
+ */
+__extension__ typedef __int128 int128_t;
+#endif
+
+/**
+ * @brief Opt-in hot-path instrumentation, live only in debug builds.
+ *
+ * Under the Makefile debug target (-DDEBUG) every operator and simplify
+ * call bumps a per-thread counter and gcd_of records an iteration-count
+ * histogram, pinpointing whether a slow job is op volume or pathological
+ * component growth. Release builds compile the hooks to empty constexpr
+ * functions, so the instrumented call sites cost nothing.
+ */
+namespace rational_stats {
+
+#ifdef DEBUG
+
+/**
+ * @brief Per-thread tallies of rational hot-path activity.
+ *
+ */
+struct counters {
+  unsigned long long adds = 0;
+  unsigned long long subs = 0;
+  unsigned long long muls = 0;
+  unsigned long long divs = 0;
+  unsigned long long simplifies = 0;
+  unsigned long long gcd_iters[32] = {};
+};
+
+/**
+ * @brief This thread's tallies.
+ *
+ */
+inline thread_local counters tally;
+
+/**
+ * @brief Record one execution of an operator.
+ *
+ * @param field The bumped counter.
+ */
+constexpr void record(unsigned long long counters::*field) noexcept {
+  if (!__builtin_is_constant_evaluated()) ++(tally.*field);
+}
+
+/**
+ * @brief Record one gcd with the given number of reduction iterations.
+ *
+ * @param iterations The loop trip count. Saturates at the last bucket.
+ */
+constexpr void record_gcd(int iterations) noexcept {
+  if (!__builtin_is_constant_evaluated()) {
+    ++tally.gcd_iters[iterations < 31 ? iterations : 31];
+  }
+}
+
+/**
+ * @brief Zero this thread's tallies.
+ *
+ */
+inline void reset() noexcept { tally = counters(); }
+
+/**
+ * @brief Dump this thread's tallies.
+ *
+ * @param out The receiving stream.
+ */
+inline void report(std::ostream& out) {
+  out << "rational ops: add " << tally.adds << ", sub " << tally.subs
+      << ", mul " << tally.muls << ", div " << tally.divs << ", simplify "
+      << tally.simplifies << '\n';
+  out << "gcd iterations:\n";
+  for (int bucket = 0; bucket < 32; ++bucket) {
+    if (tally.gcd_iters[bucket] == 0) continue;
+    out << '\t' << bucket << (bucket == 31 ? "+" : "") << ": "
+        << tally.gcd_iters[bucket] << '\n';
+  }
+}
+
+#else
+
+/**
+ * @brief Placeholder counter member pointer type for release builds.
+ *
+ */
+struct counters {
+  unsigned long long adds = 0;
+  unsigned long long subs = 0;
+  unsigned long long muls = 0;
+  unsigned long long divs = 0;
+  unsigned long long simplifies = 0;
+};
+
+/**
+ * @brief No-op in release builds.
+ *
+ */
+constexpr void record(unsigned long long counters::*) noexcept {}
+
+/**
+ * @brief No-op in release builds.
+ *
+ */
+constexpr void record_gcd(int) noexcept {}
+
+/**
+ * @brief No-op in release builds.
+ *
+ */
+inline void reset() noexcept {}
+
+/**
+ * @brief Note that instrumentation is compiled out.
+ *
+ * @param out The receiving stream.
+ */
+inline void report(std::ostream& out) {
+  out << "rational instrumentation disabled; build the debug target.\n";
+}
+
+#endif
+
+}  // namespace rational_stats
 
 /**
  * @brief Exact representation of rational numbers.
  *
  * Satisfies invariant that denominator is always positive.
+ *
+ * The component type T must be a signed integer type. Narrow components
+ * halve the memory footprint for dense containers while wide components
+ * give headroom against overflow in intermediate products.
+ *
+ * All arithmetic is defined inline as constexpr so that operations on
+ * rationals can be inlined across translation units and folded at
+ * compile-time when the operands are constants.
+ *
+ * @tparam T The integer type of the numerator and denominator.
  */
-class rational {
+template <class T>
+class rational_t {
  public:
-  using integer_t = std::int64_t;
+  using integer_t = T;
 
  private:
   integer_t num;
   integer_t denom;
 
+  /**
+   * @brief Absolute value usable in constant expressions.
+   *
+   * @param value The integer whose magnitude is taken.
+   * @return abs(value)
+   */
+  static constexpr integer_t iabs(integer_t value) noexcept {
+    return value < 0 ? -value : value;
+  }
+
+  /**
+   * @brief Count of trailing zero bits. The value must be nonzero.
+   *
+   * @param value The inspected integer. Must be positive.
+   * @return number of trailing zero bits.
+   */
+  static constexpr int ctz_of(integer_t value) noexcept {
+    if constexpr (sizeof(integer_t) <= sizeof(unsigned long long)) {
+      return __builtin_ctzll(static_cast<unsigned long long>(value));
+    } else {
+      const auto low = static_cast<unsigned long long>(value);
+      if (low != 0) return __builtin_ctzll(low);
+      return 64 + __builtin_ctzll(static_cast<unsigned long long>(
+                      value >> (4 * sizeof(integer_t))));
+    }
+  }
+
+  /**
+   * @brief Greatest common divisor usable with any component type.
+   *
+   * Stein's binary algorithm: shared powers of two factor out with ctz,
+   * and the remaining odd operands reduce by subtraction, so the hot
+   * path is shifts and subtracts with no hardware division. std::gcd
+   * rejects extended integer types under strict conformance, which also
+   * keeps this hand-rolled.
+   *
+   * @param first The first integer.
+   * @param second The second integer.
+   * @return gcd(first, second)
+   */
+  static constexpr integer_t gcd_of(integer_t first, integer_t second) noexcept {
+    auto a = iabs(first);
+    auto b = iabs(second);
+    if (a == 0) return b;
+    if (b == 0) return a;
+    if (a == 1 || b == 1) {
+      rational_stats::record_gcd(0);
+      return 1;
+    }
+    const auto a_twos = ctz_of(a);
+    const auto b_twos = ctz_of(b);
+    const auto shift = a_twos < b_twos ? a_twos : b_twos;
+    a = static_cast<integer_t>(a >> a_twos);
+    int iterations = 0;
+    do {
+      b = static_cast<integer_t>(b >> ctz_of(b));
+      if (a > b) {
+        const auto swap = a;
+        a = b;
+        b = swap;
+      }
+      b = static_cast<integer_t>(b - a);
+      ++iterations;
+    } while (b != 0);
+    rational_stats::record_gcd(iterations);
+    return static_cast<integer_t>(a << shift);
+  }
+
+  /**
+   * @brief Add o_num / o_denom to this using Knuth's two-gcd scheme.
+   *
+   * Reducing by gcd(denom, o_denom) before cross-multiplying keeps the
+   * intermediate products near the size of the operands instead of their
+   * full product, which both delays overflow and leaves only a small
+   * trailing gcd. For canonical operands the result is already
+   * canonical, so no simplify() pass is needed.
+   *
+   * @param o_num The numerator of the addend.
+   * @param o_denom The denominator of the addend.
+   */
+  constexpr void add_cross(integer_t o_num, integer_t o_denom) noexcept {
+    const auto g1 = gcd_of(denom, o_denom);
+    if (g1 == 1) {
+      num = static_cast<integer_t>(num * o_denom + denom * o_num);
+      denom = static_cast<integer_t>(denom * o_denom);
+    } else {
+      const auto t = static_cast<integer_t>(num * (o_denom / g1) +
+                                            o_num * (denom / g1));
+      const auto g2 = gcd_of(t, g1);
+      num = static_cast<integer_t>(t / g2);
+      denom = static_cast<integer_t>((denom / g1) * (o_denom / g2));
+    }
+  }
+
+
+  /**
+   * @brief Three-way comparison by cross-multiplying in a wider type.
+   *
+   * @tparam W An integer type at least twice the component width.
+   * @param ln Left numerator.
+   * @param ld Left denominator. Must be positive.
+   * @param rn Right numerator.
+   * @param rd Right denominator. Must be positive.
+   * @return negative, zero, or positive as ln/ld <, ==, > rn/rd.
+   */
+  template <class W>
+  static constexpr int compare_wide(integer_t ln, integer_t ld, integer_t rn,
+                                    integer_t rd) noexcept {
+    const auto lhs = static_cast<W>(ln) * static_cast<W>(rd);
+    const auto rhs = static_cast<W>(rn) * static_cast<W>(ld);
+    if (lhs != rhs) return lhs < rhs ? -1 : 1;
+    return 0;
+  }
+
+  /**
+   * @brief Three-way comparison without widening, for components that
+   * already use the widest available type.
+   *
+   * Walks the continued-fraction expansions of both operands in
+   * lockstep: equal whole parts recurse into the reciprocals of the
+   * fractional parts, which flips the order each step. Division-based,
+   * but never overflows at any component width.
+   *
+   * @param ln Left numerator.
+   * @param ld Left denominator. Must be positive.
+   * @param rn Right numerator.
+   * @param rd Right denominator. Must be positive.
+   * @return negative, zero, or positive as ln/ld <, ==, > rn/rd.
+   */
+  static constexpr int compare_exact(integer_t ln, integer_t ld, integer_t rn,
+                                     integer_t rd) noexcept {
+    const auto left_neg = ln < 0;
+    const auto right_neg = rn < 0;
+    if (left_neg != right_neg) return left_neg ? -1 : 1;
+    auto a = iabs(ln);
+    auto b = ld;
+    auto c = iabs(rn);
+    auto d = rd;
+    int flip = left_neg ? -1 : 1;
+    while (true) {
+      const auto q1 = static_cast<integer_t>(a / b);
+      const auto q2 = static_cast<integer_t>(c / d);
+      if (q1 != q2) return (q1 < q2 ? -1 : 1) * flip;
+      const auto r1 = static_cast<integer_t>(a % b);
+      const auto r2 = static_cast<integer_t>(c % d);
+      if (r1 == 0 || r2 == 0) {
+        if (r1 == r2) return 0;
+        return (r1 == 0 ? -1 : 1) * flip;
+      }
+      a = b;
+      c = d;
+      b = r1;
+      d = r2;
+      flip = -flip;
+    }
+  }
+
+
+  /**
+   * @brief Parse an optionally signed run of decimal digits.
+   *
+   * Hand-rolled rather than delegating to std::from_chars so that every
+   * component width parses, including __int128.
+   *
+   * @param first Start of the character range.
+   * @param last One past the end of the character range.
+   * @param out Receives the parsed value on success.
+   * @return pointer past the digits and an error code, std::from_chars
+   * style. On failure out is untouched and ptr equals first.
+   */
+  static std::from_chars_result parse_int(const char* first, const char* last,
+                                          integer_t& out) noexcept {
+    constexpr auto int_max = static_cast<integer_t>(
+        ~(static_cast<integer_t>(1) << (8 * sizeof(integer_t) - 1)));
+    auto ptr = first;
+    bool neg = false;
+    if (ptr != last && *ptr == '-') {
+      neg = true;
+      ++ptr;
+    }
+    const auto digits = ptr;
+    integer_t mag = 0;
+    for (; ptr != last && *ptr >= '0' && *ptr <= '9'; ++ptr) {
+      const auto digit = static_cast<integer_t>(*ptr - '0');
+      if (mag > (int_max - digit) / 10) {
+        return {first, std::errc::result_out_of_range};
+      }
+      mag = static_cast<integer_t>(mag * 10 + digit);
+    }
+    if (ptr == digits) return {first, std::errc::invalid_argument};
+    out = neg ? static_cast<integer_t>(-mag) : mag;
+    return {ptr, std::errc()};
+  }
+
+  /**
+   * @brief Write an integer as decimal digits.
+   *
+   * Hand-rolled rather than delegating to std::to_chars so that every
+   * component width formats, including __int128. Digits extract from the
+   * negated magnitude so the minimum value needs no special case.
+   *
+   * @param first Start of the character range.
+   * @param last One past the end of the character range.
+   * @param value The written integer.
+   * @return pointer past the digits and an error code, std::to_chars
+   * style. On overflow nothing is written.
+   */
+  static std::to_chars_result write_int(char* first, char* last,
+                                        integer_t value) noexcept {
+    char digits[48];
+    auto cursor = digits + sizeof(digits);
+    const bool neg = value < 0;
+    auto mag = neg ? value : static_cast<integer_t>(-value);
+    do {
+      *--cursor = static_cast<char>('0' - static_cast<int>(mag % 10));
+      mag = static_cast<integer_t>(mag / 10);
+    } while (mag != 0);
+    if (neg) *--cursor = '-';
+    if (digits + sizeof(digits) - cursor > last - first) {
+      return {last, std::errc::value_too_large};
+    }
+    while (cursor != digits + sizeof(digits)) *first++ = *cursor++;
+    return {first, std::errc()};
+  }
+
   /**
    * @brief Reduces num and denom such that they are relatively prime.
    *
+   * Integer values and coprime components, the two overwhelmingly common
+   * cases, exit before any division happens.
    */
-  void simplify();
+  constexpr void simplify() noexcept {
+    rational_stats::record(&rational_stats::counters::simplifies);
+    if (denom == 1) return;
+    const auto div = gcd_of(num, denom);
+    if (div != 1) {
+      num = static_cast<integer_t>(num / div);
+      denom = static_cast<integer_t>(denom / div);
+    }
+    if ((num < 0) != (denom < 0)) {
+      num = static_cast<integer_t>(-iabs(num));
+      denom = iabs(denom);
+    } else if ((num < 0) && (denom < 0)) {
+      num = static_cast<integer_t>(-num);
+      denom = static_cast<integer_t>(-denom);
+    }
+  }
 
  public:
+  /**
+   * @brief Tag selecting constructors and operations that defer reduction.
+   *
+   */
+  struct unreduced_t {};
+
+  /**
+   * @brief Tag value for the deferred-reduction overloads.
+   *
+   */
+  static constexpr unreduced_t unreduced{};
+
   /**
    * @brief Disallow no-arg default constructor.
    *
    */
-  rational() = delete;
+  rational_t() = delete;
 
   /**
    * @brief Construct a rational given its integer value.
    *
    * @param value The value of the constructed rational.
    */
-  explicit rational(integer_t value);
+  explicit constexpr rational_t(integer_t value) noexcept
+      : num(value), denom(1) {}
 
   /**
    * @brief Construct a rational given numerator and denominator.
@@ -51,14 +452,44 @@ class rational {
    * @param numerator The numerator.
    * @param denominator The denominator.
    */
-  rational(integer_t numerator, integer_t denominator);
+  constexpr rational_t(integer_t numerator, integer_t denominator)
+      : num(numerator), denom(denominator) {
+    if (denom == 0) {
+      throw std::invalid_argument("Denominator must be non-zero.");
+    }
+    simplify();
+  }
+
+  /**
+   * @brief Construct a rational without reducing it.
+   *
+   * The components are stored verbatim, so the co-prime invariant is
+   * suspended until normalize() is called. Intended for accumulation
+   * loops where only the final value needs canonical form.
+   *
+   * @param numerator The numerator.
+   * @param denominator The denominator.
+   */
+  constexpr rational_t(unreduced_t, integer_t numerator, integer_t denominator)
+      : num(numerator), denom(denominator) {
+    if (denom == 0) {
+      throw std::invalid_argument("Denominator must be non-zero.");
+    }
+  }
 
   /**
    * @brief Copy constructor.
    *
    * @param other The rational to copy into this.
    */
-  rational(const rational& other);
+  constexpr rational_t(const rational_t& other) noexcept = default;
+
+  /**
+   * @brief Move constructor.
+   *
+   * @param other The rational to move into this.
+   */
+  constexpr rational_t(rational_t&& other) noexcept = default;
 
   /**
    * @brief Assignment operator.
@@ -66,42 +497,438 @@ class rational {
    * @param other The rational to assign to this.
    * @return this
    */
-  rational& operator=(const rational& other);
+  constexpr rational_t& operator=(const rational_t& other) noexcept = default;
+
+  /**
+   * @brief Move assignment operator.
+   *
+   * @param other The rational to move-assign to this.
+   * @return this
+   */
+  constexpr rational_t& operator=(rational_t&& other) noexcept = default;
+
+  /**
+   * @brief Restore the co-prime and positive-denominator invariants.
+   *
+   * Reduces a rational built or combined through the unreduced overloads.
+   * One call at the end of a chain replaces the per-operation gcd.
+   *
+   * @return this
+   */
+  constexpr rational_t& normalize() noexcept {
+    simplify();
+    return *this;
+  }
+
+  /**
+   * @brief Add another rational without reducing the result.
+   *
+   * @param other The other rational.
+   * @return this
+   */
+  constexpr rational_t& add_unreduced(const rational_t& other) noexcept {
+    num = static_cast<integer_t>(num * other.denom + denom * other.num);
+    denom = static_cast<integer_t>(denom * other.denom);
+    return *this;
+  }
+
+  /**
+   * @brief Subtract another rational without reducing the result.
+   *
+   * @param other The other rational.
+   * @return this
+   */
+  constexpr rational_t& sub_unreduced(const rational_t& other) noexcept {
+    num = static_cast<integer_t>(num * other.denom - denom * other.num);
+    denom = static_cast<integer_t>(denom * other.denom);
+    return *this;
+  }
+
+  /**
+   * @brief Multiply another rational without reducing the result.
+   *
+   * @param other The other rational.
+   * @return this
+   */
+  constexpr rational_t& mul_unreduced(const rational_t& other) noexcept {
+    num = static_cast<integer_t>(num * other.num);
+    denom = static_cast<integer_t>(denom * other.denom);
+    return *this;
+  }
+
+  /**
+   * @brief Divide by another rational without reducing the result.
+   *
+   * @param other The other rational.
+   * @return this
+   */
+  constexpr rational_t& div_unreduced(const rational_t& other) {
+    if (other.num == 0) {
+      throw std::invalid_argument("Cannot divide by zero.");
+    }
+    num = static_cast<integer_t>(num * other.denom);
+    denom = static_cast<integer_t>(denom * other.num);
+    return *this;
+  }
 
   /**
    * @brief Unsigned value of the numerator. Relatively prime to denominator.
    *
    * @return integer absolute value of numerator.
    */
-  integer_t numerator() const;
+  constexpr integer_t numerator() const noexcept { return num; }
 
   /**
    * @brief Unsigned value of the deminator. Relatively prime to numerator.
    *
    * @return integer absolute value of denominator.
    */
-  integer_t denominator() const;
+  constexpr integer_t denominator() const noexcept { return denom; }
 
   /**
    * @brief Get approximate value of the rational.
    *
    * @return double approximation of rational.
    */
-  double value() const;
+  constexpr double value() const noexcept {
+    return static_cast<double>(num) / static_cast<double>(denom);
+  }
+
+
+
+  /**
+   * @brief Guaranteed-layout record for binary serialization.
+   *
+   * Two native-endian components in declaration order, matching the
+   * in-memory layout of rational_t itself. 16 bytes for the default
+   * 64-bit component width.
+   */
+  struct packed {
+    integer_t num;
+    integer_t denom;
+  };
+
+  /**
+   * @brief Copy this into a packed record.
+   *
+   * @return packed record with the canonical components.
+   */
+  constexpr packed to_packed() const noexcept { return {num, denom}; }
+
+  /**
+   * @brief Rebuild a rational from a packed record.
+   *
+   * Trusts that the record was produced by to_packed, so no reduction
+   * runs; a zero denominator from a corrupted source still throws.
+   *
+   * @param record The packed record.
+   * @return rational with the record's components.
+   */
+  static constexpr rational_t from_packed(const packed& record) {
+    return rational_t(unreduced, record.num, record.denom);
+  }
+
+  /**
+   * @brief Hash of the canonical component pair.
+   *
+   * Mixes num and denom through a splitmix64-style finalizer, so equal
+   * rationals hash equal with no formatting or allocation. Suitable for
+   * std::unordered_map via the std::hash specialization below.
+   *
+   * @return size_t hash of this.
+   */
+  constexpr std::size_t hash_code() const noexcept {
+    const auto mix = [](std::uint64_t x) {
+      x += 0x9e3779b97f4a7c15ULL;
+      x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+      return x ^ (x >> 31);
+    };
+    const auto num_hash = mix(static_cast<std::uint64_t>(num));
+    const auto denom_hash = mix(static_cast<std::uint64_t>(denom));
+    return static_cast<std::size_t>(num_hash ^
+                                    (denom_hash * 0xff51afd7ed558ccdULL));
+  }
+
+
+  /**
+   * @brief Best approximation with a bounded denominator.
+   *
+   * Walks the continued-fraction convergents of this until the
+   * denominator cap is hit, then decides between the last convergent
+   * and the best semiconvergent. Clamping magnitudes mid-pipeline keeps
+   * later arithmetic in the cheap small-component regime.
+   *
+   * @param max_denominator The largest denominator allowed. Must be
+   * positive.
+   * @return closest rational to this with denominator <= the cap.
+   */
+  constexpr rational_t approximate(integer_t max_denominator) const {
+    if (max_denominator < 1) {
+      throw std::invalid_argument("Denominator cap must be positive.");
+    }
+    if (denom <= max_denominator) return *this;
+    const bool neg = num < 0;
+    auto n = iabs(num);
+    auto d = denom;
+    const auto wanted =
+        static_cast<long double>(n) / static_cast<long double>(d);
+    integer_t h2 = 0;
+    integer_t k2 = 1;
+    integer_t h1 = 1;
+    integer_t k1 = 0;
+    while (true) {
+      const auto a = static_cast<integer_t>(n / d);
+      if (k1 != 0 && a > (max_denominator - k2) / k1) {
+        const auto t = static_cast<integer_t>((max_denominator - k2) / k1);
+        const auto semi_num = static_cast<integer_t>(t * h1 + h2);
+        const auto semi_denom = static_cast<integer_t>(t * k1 + k2);
+        bool use_semi = 2 * t > a;
+        if (2 * t == a) {
+          // Tie on the halved term: compare the two errors against the
+          // original value, not the continued-fraction tail in n/d.
+          auto semi_err = wanted - static_cast<long double>(semi_num) /
+                                       static_cast<long double>(semi_denom);
+          auto conv_err = wanted - static_cast<long double>(h1) /
+                                       static_cast<long double>(k1);
+          if (semi_err < 0) semi_err = -semi_err;
+          if (conv_err < 0) conv_err = -conv_err;
+          use_semi = semi_err < conv_err;
+        }
+        const auto best_num = use_semi ? semi_num : h1;
+        const auto best_denom = use_semi ? semi_denom : k1;
+        return rational_t(unreduced,
+                          neg ? static_cast<integer_t>(-best_num) : best_num,
+                          best_denom);
+      }
+      const auto h = static_cast<integer_t>(a * h1 + h2);
+      const auto k = static_cast<integer_t>(a * k1 + k2);
+      h2 = h1;
+      h1 = h;
+      k2 = k1;
+      k1 = k;
+      const auto rem = static_cast<integer_t>(n % d);
+      if (rem == 0) {
+        return rational_t(unreduced,
+                          neg ? static_cast<integer_t>(-h1) : h1, k1);
+      }
+      n = d;
+      d = rem;
+    }
+  }
+
+  /**
+   * @brief Recover a rational from a double, bounding the denominator.
+   *
+   * Inverse of value(): expands the continued fraction of the double
+   * until the cap or the precision of the input is exhausted.
+   * Convergents are co-prime by construction, so no reduction runs.
+   *
+   * @param target The value to approximate. Must be finite and within
+   * the component range.
+   * @param max_denominator The largest denominator allowed. Must be
+   * positive.
+   * @return closest rational to target with denominator <= the cap.
+   */
+  static rational_t from_double(double target, integer_t max_denominator) {
+    if (max_denominator < 1) {
+      throw std::invalid_argument("Denominator cap must be positive.");
+    }
+    constexpr auto int_max = static_cast<integer_t>(
+        ~(static_cast<integer_t>(1) << (8 * sizeof(integer_t) - 1)));
+    if (!std::isfinite(target) ||
+        target >= static_cast<double>(int_max) ||
+        target <= -static_cast<double>(int_max)) {
+      throw std::invalid_argument("Value must be finite and in range.");
+    }
+    const bool neg = target < 0;
+    const auto wanted = neg ? -target : target;
+    auto x = wanted;
+    integer_t h2 = 0;
+    integer_t k2 = 1;
+    integer_t h1 = 1;
+    integer_t k1 = 0;
+    for (int iter = 0; iter < 64; ++iter) {
+      const auto whole = static_cast<integer_t>(x);
+      if (k1 != 0 && whole > (max_denominator - k2) / k1) {
+        // The next convergent busts the cap; the best semiconvergent may
+        // still beat the current convergent.
+        const auto t = static_cast<integer_t>((max_denominator - k2) / k1);
+        if (t > 0) {
+          const auto semi_num = static_cast<integer_t>(t * h1 + h2);
+          const auto semi_denom = static_cast<integer_t>(t * k1 + k2);
+          auto semi_err = wanted - static_cast<double>(semi_num) /
+                                       static_cast<double>(semi_denom);
+          auto conv_err = wanted - static_cast<double>(h1) /
+                                       static_cast<double>(k1);
+          if (semi_err < 0) semi_err = -semi_err;
+          if (conv_err < 0) conv_err = -conv_err;
+          if (semi_err < conv_err) {
+            h1 = semi_num;
+            k1 = semi_denom;
+          }
+        }
+        break;
+      }
+      if (h1 != 0 && whole > (int_max - h2) / h1) break;
+      h2 = std::exchange(h1, static_cast<integer_t>(whole * h1 + h2));
+      k2 = std::exchange(k1, static_cast<integer_t>(whole * k1 + k2));
+      const auto frac = x - static_cast<double>(whole);
+      if (frac < 1e-12) break;
+      x = 1.0 / frac;
+    }
+    return rational_t(unreduced, neg ? static_cast<integer_t>(-h1) : h1, k1);
+  }
+
+  /**
+   * @brief Recover the minimal-denominator rational rounding to a double.
+   *
+   * Walks the Stern-Brocot tree over the double's rounding interval: the
+   * first mediant landing inside the half-ulp neighborhood of the target
+   * is the unique smallest-denominator rational whose value() reproduces
+   * it, so a value squeezed through value() upstream comes back as the
+   * original fraction. Runs of steps toward one side batch into a single
+   * jump, keeping the walk logarithmic. Mediants are co-prime by
+   * construction, so the result feeds the reduced-form invariant with no
+   * simplify. If the cap or the component range is hit first, the
+   * closest mediant reached is returned.
+   *
+   * @param target The value to recover. Must be finite and within the
+   * component range.
+   * @param max_iterations The cap on tree descents.
+   * @return smallest-denominator rational within half an ulp of target.
+   */
+  static rational_t from_value(double target, unsigned max_iterations = 128) {
+    constexpr auto int_max = static_cast<integer_t>(
+        ~(static_cast<integer_t>(1) << (8 * sizeof(integer_t) - 1)));
+    if (!std::isfinite(target) ||
+        target >= static_cast<double>(int_max) ||
+        target <= -static_cast<double>(int_max)) {
+      throw std::invalid_argument("Value must be finite and in range.");
+    }
+    const bool neg = target < 0;
+    const auto wanted = neg ? -target : target;
+    const auto whole = static_cast<integer_t>(wanted);
+    const auto frac = wanted - static_cast<double>(whole);
+    const auto below =
+        std::nextafter(wanted, 0.0) - static_cast<double>(whole);
+    const auto above = std::nextafter(wanted, static_cast<double>(int_max)) -
+                       static_cast<double>(whole);
+    const auto lo_bound = frac - (frac - below) / 2;
+    const auto hi_bound = frac + (above - frac) / 2;
+    auto build = [neg, whole](integer_t mn, integer_t md) {
+      const auto n = static_cast<integer_t>(whole * md + mn);
+      return rational_t(unreduced, neg ? static_cast<integer_t>(-n) : n, md);
+    };
+    if (lo_bound <= 0.0) return build(0, 1);
+    if (hi_bound >= 1.0) return build(1, 1);
+    integer_t ln = 0;
+    integer_t ld = 1;
+    integer_t hn = 1;
+    integer_t hd = 1;
+    for (unsigned iter = 0; iter < max_iterations; ++iter) {
+      if (hd > static_cast<integer_t>(int_max - ld)) break;
+      const auto mn = static_cast<integer_t>(ln + hn);
+      const auto md = static_cast<integer_t>(ld + hd);
+      const auto mediant = static_cast<double>(mn) / static_cast<double>(md);
+      if (mediant < lo_bound) {
+        // Batch every step that stays left of the interval into one jump.
+        const auto room = static_cast<integer_t>((int_max - ld) / hd);
+        const auto steps = (lo_bound * static_cast<double>(ld) -
+                            static_cast<double>(ln)) /
+                           (static_cast<double>(hn) -
+                            lo_bound * static_cast<double>(hd));
+        // Back off one step so double rounding can never jump past the
+        // interval.
+        auto k = steps > 2.0 ? static_cast<integer_t>(steps - 1.0)
+                             : static_cast<integer_t>(1);
+        if (k >= room) break;
+        ln = static_cast<integer_t>(ln + k * hn);
+        ld = static_cast<integer_t>(ld + k * hd);
+      } else if (mediant > hi_bound) {
+        const auto room = static_cast<integer_t>((int_max - hd) / ld);
+        const auto steps = (static_cast<double>(hn) -
+                            hi_bound * static_cast<double>(hd)) /
+                           (hi_bound * static_cast<double>(ld) -
+                            static_cast<double>(ln));
+        auto k = steps > 2.0 ? static_cast<integer_t>(steps - 1.0)
+                             : static_cast<integer_t>(1);
+        if (k >= room) break;
+        hn = static_cast<integer_t>(hn + k * ln);
+        hd = static_cast<integer_t>(hd + k * ld);
+      } else {
+        return build(mn, md);
+      }
+    }
+    // Cap or component range exhausted; the tighter bound is the best
+    // mediant reached.
+    const auto lo_err = frac - static_cast<double>(ln) / static_cast<double>(ld);
+    const auto hi_err = static_cast<double>(hn) / static_cast<double>(hd) - frac;
+    return lo_err < hi_err ? build(ln, ld) : build(hn, hd);
+  }
+
+  /**
+   * @brief Reciprocal in place: swap components and fix the sign.
+   *
+   * Coprimality survives the swap, so no gcd runs and no temporary is
+   * built.
+   *
+   * @return this
+   */
+  constexpr rational_t& invert() {
+    if (num == 0) {
+      throw std::invalid_argument("Cannot divide by zero.");
+    }
+    const auto held = num;
+    num = denom;
+    denom = held;
+    if (denom < 0) {
+      num = static_cast<integer_t>(-num);
+      denom = static_cast<integer_t>(-denom);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Flip the sign in place. The denominator stays positive.
+   *
+   * @return this
+   */
+  constexpr rational_t& negate() noexcept {
+    num = static_cast<integer_t>(-num);
+    return *this;
+  }
+
+  /**
+   * @brief Absolute value in place.
+   *
+   * Abs of a reduced fraction is already reduced, so this is one sign
+   * test against the unary operator's constructor round trip.
+   *
+   * @return this
+   */
+  constexpr rational_t& make_abs() noexcept {
+    num = iabs(num);
+    return *this;
+  }
 
   /**
    * @brief Absolute value of this.
    *
    * @return abs(this)
    */
-  rational operator+() const;
+  constexpr rational_t operator+() const noexcept {
+    return rational_t(iabs(num), iabs(denom));
+  }
 
   /**
    * @brief Opposite sign of this.
    *
    * @return this reflected through 0
    */
-  rational operator-() const;
+  constexpr rational_t operator-() const noexcept {
+    return rational_t(static_cast<integer_t>(-num), denom);
+  }
 
   /**
    * @brief Add another rational.
@@ -109,7 +936,11 @@ class rational {
    * @param other The other rational.
    * @return this
    */
-  rational& operator+=(const rational& other);
+  constexpr rational_t& operator+=(const rational_t& other) noexcept {
+    rational_stats::record(&rational_stats::counters::adds);
+    add_cross(other.num, other.denom);
+    return *this;
+  }
 
   /**
    * @brief Binary addition.
@@ -118,7 +949,11 @@ class rational {
    * @param right Right side rational.
    * @return operation on left and right.
    */
-  friend rational operator+(rational left, const rational& right);
+  friend constexpr rational_t operator+(rational_t left,
+                                        const rational_t& right) noexcept {
+    left += right;
+    return left;
+  }
 
   /**
    * @brief Subtract another rational.
@@ -126,7 +961,11 @@ class rational {
    * @param other The other rational.
    * @return this
    */
-  rational& operator-=(const rational& other);
+  constexpr rational_t& operator-=(const rational_t& other) noexcept {
+    rational_stats::record(&rational_stats::counters::subs);
+    add_cross(static_cast<integer_t>(-other.num), other.denom);
+    return *this;
+  }
 
   /**
    * @brief Binary subtraction.
@@ -135,7 +974,11 @@ class rational {
    * @param right Right side rational.
    * @return operation on left and right.
    */
-  friend rational operator-(rational left, const rational& right);
+  friend constexpr rational_t operator-(rational_t left,
+                                        const rational_t& right) noexcept {
+    left -= right;
+    return left;
+  }
 
   /**
    * @brief Multiply another rational.
@@ -143,7 +986,13 @@ class rational {
    * @param other The other rational.
    * @return this
    */
-  rational& operator*=(const rational& other);
+  constexpr rational_t& operator*=(const rational_t& other) noexcept {
+    rational_stats::record(&rational_stats::counters::muls);
+    num = static_cast<integer_t>(num * other.num);
+    denom = static_cast<integer_t>(denom * other.denom);
+    simplify();
+    return *this;
+  }
 
   /**
    * @brief Binary multiplication.
@@ -152,7 +1001,11 @@ class rational {
    * @param right Right side rational.
    * @return operation on left and right.
    */
-  friend rational operator*(rational left, const rational& right);
+  friend constexpr rational_t operator*(rational_t left,
+                                        const rational_t& right) noexcept {
+    left *= right;
+    return left;
+  }
 
   /**
    * @brief Divide another rational.
@@ -160,7 +1013,16 @@ class rational {
    * @param other The other rational.
    * @return this
    */
-  rational& operator/=(const rational& other);
+  constexpr rational_t& operator/=(const rational_t& other) {
+    rational_stats::record(&rational_stats::counters::divs);
+    if (other.num == 0) {
+      throw std::invalid_argument("Cannot divide by zero.");
+    }
+    num = static_cast<integer_t>(num * other.denom);
+    denom = static_cast<integer_t>(denom * other.num);
+    simplify();
+    return *this;
+  }
 
   /**
    * @brief Binary division.
@@ -169,35 +1031,305 @@ class rational {
    * @param right Right side rational.
    * @return operation on left and right.
    */
-  friend rational operator/(rational left, const rational& right);
+  friend constexpr rational_t operator/(rational_t left,
+                                        const rational_t& right) {
+    left /= right;
+    return left;
+  }
+
+
+  /**
+   * @brief Add a whole number. No gcd: the denominator is unchanged.
+   *
+   * @param value The integer addend.
+   * @return this
+   */
+  constexpr rational_t& operator+=(integer_t value) noexcept {
+    num = static_cast<integer_t>(num + value * denom);
+    return *this;
+  }
+
+  /**
+   * @brief Subtract a whole number. No gcd: the denominator is unchanged.
+   *
+   * @param value The integer subtrahend.
+   * @return this
+   */
+  constexpr rational_t& operator-=(integer_t value) noexcept {
+    num = static_cast<integer_t>(num - value * denom);
+    return *this;
+  }
+
+  /**
+   * @brief Multiply by a whole number.
+   *
+   * Needs only the small gcd(value, denom) instead of a full-width
+   * reduction, since num is already co-prime to denom.
+   *
+   * @param value The integer factor.
+   * @return this
+   */
+  constexpr rational_t& operator*=(integer_t value) noexcept {
+    const auto div = gcd_of(value, denom);
+    num = static_cast<integer_t>(num * (value / div));
+    denom = static_cast<integer_t>(denom / div);
+    return *this;
+  }
+
+  /**
+   * @brief Divide by a whole number.
+   *
+   * Needs only the small gcd(value, num) instead of a full-width
+   * reduction, since num is already co-prime to denom.
+   *
+   * @param value The integer divisor.
+   * @return this
+   */
+  constexpr rational_t& operator/=(integer_t value) {
+    if (value == 0) {
+      throw std::invalid_argument("Cannot divide by zero.");
+    }
+    const auto div = gcd_of(value, num);
+    num = static_cast<integer_t>(num / div);
+    denom = static_cast<integer_t>(denom * (value / div));
+    if (denom < 0) {
+      num = static_cast<integer_t>(-num);
+      denom = static_cast<integer_t>(-denom);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Binary addition with a whole number.
+   *
+   * @param left Left side rational.
+   * @param right Right side integer.
+   * @return operation on left and right.
+   */
+  friend constexpr rational_t operator+(rational_t left,
+                                        integer_t right) noexcept {
+    left += right;
+    return left;
+  }
+
+  /**
+   * @brief Binary addition with a whole number.
+   *
+   * @param left Left side integer.
+   * @param right Right side rational.
+   * @return operation on left and right.
+   */
+  friend constexpr rational_t operator+(integer_t left,
+                                        rational_t right) noexcept {
+    right += left;
+    return right;
+  }
+
+  /**
+   * @brief Binary subtraction of a whole number.
+   *
+   * @param left Left side rational.
+   * @param right Right side integer.
+   * @return operation on left and right.
+   */
+  friend constexpr rational_t operator-(rational_t left,
+                                        integer_t right) noexcept {
+    left -= right;
+    return left;
+  }
+
+  /**
+   * @brief Binary subtraction from a whole number.
+   *
+   * @param left Left side integer.
+   * @param right Right side rational.
+   * @return operation on left and right.
+   */
+  friend constexpr rational_t operator-(integer_t left,
+                                        rational_t right) noexcept {
+    right -= left;
+    right.num = static_cast<integer_t>(-right.num);
+    return right;
+  }
+
+  /**
+   * @brief Binary multiplication with a whole number.
+   *
+   * @param left Left side rational.
+   * @param right Right side integer.
+   * @return operation on left and right.
+   */
+  friend constexpr rational_t operator*(rational_t left,
+                                        integer_t right) noexcept {
+    left *= right;
+    return left;
+  }
+
+  /**
+   * @brief Binary multiplication with a whole number.
+   *
+   * @param left Left side integer.
+   * @param right Right side rational.
+   * @return operation on left and right.
+   */
+  friend constexpr rational_t operator*(integer_t left,
+                                        rational_t right) noexcept {
+    right *= left;
+    return right;
+  }
+
+  /**
+   * @brief Binary division by a whole number.
+   *
+   * @param left Left side rational.
+   * @param right Right side integer.
+   * @return operation on left and right.
+   */
+  friend constexpr rational_t operator/(rational_t left, integer_t right) {
+    left /= right;
+    return left;
+  }
+
+  /**
+   * @brief Binary division of a whole number.
+   *
+   * @param left Left side integer.
+   * @param right Right side rational.
+   * @return operation on left and right.
+   */
+  friend constexpr rational_t operator/(integer_t left,
+                                        const rational_t& right) {
+    if (right.num == 0) {
+      throw std::invalid_argument("Cannot divide by zero.");
+    }
+    auto flipped = rational_t(unreduced, right.denom, right.num);
+    if (flipped.denom < 0) {
+      flipped.num = static_cast<integer_t>(-flipped.num);
+      flipped.denom = static_cast<integer_t>(-flipped.denom);
+    }
+    flipped *= left;
+    return flipped;
+  }
+
+  /**
+   * @brief Raise to an integer power by square-and-multiply.
+   *
+   * Coprime components stay coprime under powers, so the squaring loop
+   * runs on the raw components with no intermediate simplify and the
+   * result needs no trailing gcd either. A negative exponent raises the
+   * reciprocal to the positive power.
+   *
+   * @param exponent The integer power.
+   * @return this rational raised to exponent.
+   */
+  constexpr rational_t pow(int exponent) const {
+    auto base_num = num;
+    auto base_denom = denom;
+    if (exponent < 0) {
+      if (num == 0) {
+        throw std::invalid_argument("Cannot divide by zero.");
+      }
+      base_num = num < 0 ? static_cast<integer_t>(-denom) : denom;
+      base_denom = iabs(num);
+    }
+    auto steps = exponent < 0 ? 0u - static_cast<unsigned>(exponent)
+                              : static_cast<unsigned>(exponent);
+    auto result_num = static_cast<integer_t>(1);
+    auto result_denom = static_cast<integer_t>(1);
+    while (steps != 0) {
+      if ((steps & 1u) != 0) {
+        result_num = static_cast<integer_t>(result_num * base_num);
+        result_denom = static_cast<integer_t>(result_denom * base_denom);
+      }
+      steps >>= 1u;
+      if (steps != 0) {
+        base_num = static_cast<integer_t>(base_num * base_num);
+        base_denom = static_cast<integer_t>(base_denom * base_denom);
+      }
+    }
+    return rational_t(unreduced, result_num, result_denom);
+  }
 
   /**
    * @brief Prefix increment by one.
    *
    * @return this
    */
-  rational& operator++();
+  constexpr rational_t& operator++() noexcept {
+    num = static_cast<integer_t>(num + iabs(denom));
+    return *this;
+  }
 
   /**
    * @brief Postfix increment by one.
    *
    * @return copy of this
    */
-  rational operator++(int);
+  constexpr rational_t operator++(int) noexcept {
+    auto old = *this;
+    operator++();
+    return old;
+  }
 
   /**
    * @brief Prefix decrement by one.
    *
    * @return this
    */
-  rational& operator--();
+  constexpr rational_t& operator--() noexcept {
+    num = static_cast<integer_t>(num - iabs(denom));
+    return *this;
+  }
 
   /**
    * @brief Postfix decrement by one.
    *
    * @return copy of this
    */
-  rational operator--(int);
+  constexpr rational_t operator--(int) noexcept {
+    auto old = *this;
+    operator--();
+    return old;
+  }
+
+
+  /**
+   * @brief Three-way comparison that cannot overflow.
+   *
+   * One computation serves all six relational operators: components up
+   * to 64 bits cross-multiply in a doubled-width type, and the widest
+   * components fall back to an exact continued-fraction walk. The
+   * standard pins this codebase to C++17, so this member stands in for
+   * operator<=>.
+   *
+   * @param other The rational compared against.
+   * @return negative, zero, or positive as this <, ==, > other.
+   */
+  constexpr int compare(const rational_t& other) const noexcept {
+    auto ln = num;
+    auto ld = denom;
+    if (ld < 0) {
+      ln = static_cast<integer_t>(-ln);
+      ld = static_cast<integer_t>(-ld);
+    }
+    auto rn = other.num;
+    auto rd = other.denom;
+    if (rd < 0) {
+      rn = static_cast<integer_t>(-rn);
+      rd = static_cast<integer_t>(-rd);
+    }
+    if constexpr (sizeof(integer_t) <= 4) {
+      return compare_wide<std::int64_t>(ln, ld, rn, rd);
+    }
+#ifdef __SIZEOF_INT128__
+    else if constexpr (sizeof(integer_t) <= 8) {
+      return compare_wide<int128_t>(ln, ld, rn, rd);
+    }
+#endif
+    else {
+      return compare_exact(ln, ld, rn, rd);
+    }
+  }
 
   /**
    * @brief Equality comparison.
@@ -206,7 +1338,10 @@ class rational {
    * @param right Right side rational.
    * @return whether relation is satisfied.
    */
-  friend bool operator==(const rational& left, const rational& right);
+  friend constexpr bool operator==(const rational_t& left,
+                                   const rational_t& right) noexcept {
+    return left.compare(right) == 0;
+  }
 
   /**
    * @brief Inequality comparison.
@@ -215,7 +1350,10 @@ class rational {
    * @param right Right side rational.
    * @return whether relation is satisfied.
    */
-  friend bool operator!=(const rational& left, const rational& right);
+  friend constexpr bool operator!=(const rational_t& left,
+                                   const rational_t& right) noexcept {
+    return !(left == right);
+  }
 
   /**
    * @brief Less than comparison.
@@ -224,7 +1362,10 @@ class rational {
    * @param right Right side rational.
    * @return whether relation is satisfied.
    */
-  friend bool operator<(const rational& left, const rational& right);
+  friend constexpr bool operator<(const rational_t& left,
+                                  const rational_t& right) noexcept {
+    return left.compare(right) < 0;
+  }
 
   /**
    * @brief Less than or equal to comparison.
@@ -233,7 +1374,10 @@ class rational {
    * @param right Right side rational.
    * @return whether relation is satisfied.
    */
-  friend bool operator<=(const rational& left, const rational& right);
+  friend constexpr bool operator<=(const rational_t& left,
+                                   const rational_t& right) noexcept {
+    return left.compare(right) <= 0;
+  }
 
   /**
    * @brief Greater than comparison.
@@ -242,7 +1386,10 @@ class rational {
    * @param right Right side rational.
    * @return whether relation is satisfied.
    */
-  friend bool operator>(const rational& left, const rational& right);
+  friend constexpr bool operator>(const rational_t& left,
+                                  const rational_t& right) noexcept {
+    return left.compare(right) > 0;
+  }
 
   /**
    * @brief Greater than or equal to comparison.
@@ -251,7 +1398,247 @@ class rational {
    * @param right Right side rational.
    * @return whether relation is satisfied.
    */
-  friend bool operator>=(const rational& left, const rational& right);
+  friend constexpr bool operator>=(const rational_t& left,
+                                   const rational_t& right) noexcept {
+    return left.compare(right) >= 0;
+  }
+
+
+  /**
+   * @brief Equality comparison against a whole number. No multiplication:
+   * canonical form means equality holds exactly when denom is one.
+   *
+   * @param left Left side rational.
+   * @param right Right side integer.
+   * @return whether relation is satisfied.
+   */
+  friend constexpr bool operator==(const rational_t& left,
+                                   integer_t right) noexcept {
+    return left.denom == 1 && left.num == right;
+  }
+
+  /**
+   * @brief Equality comparison against a whole number.
+   *
+   * @param left Left side integer.
+   * @param right Right side rational.
+   * @return whether relation is satisfied.
+   */
+  friend constexpr bool operator==(integer_t left,
+                                   const rational_t& right) noexcept {
+    return right == left;
+  }
+
+  /**
+   * @brief Inequality comparison against a whole number.
+   *
+   * @param left Left side rational.
+   * @param right Right side integer.
+   * @return whether relation is satisfied.
+   */
+  friend constexpr bool operator!=(const rational_t& left,
+                                   integer_t right) noexcept {
+    return !(left == right);
+  }
+
+  /**
+   * @brief Inequality comparison against a whole number.
+   *
+   * @param left Left side integer.
+   * @param right Right side rational.
+   * @return whether relation is satisfied.
+   */
+  friend constexpr bool operator!=(integer_t left,
+                                   const rational_t& right) noexcept {
+    return !(right == left);
+  }
+
+  /**
+   * @brief Less than comparison against a whole number. One product
+   * against the canonical positive denominator.
+   *
+   * @param left Left side rational.
+   * @param right Right side integer.
+   * @return whether relation is satisfied.
+   */
+  friend constexpr bool operator<(const rational_t& left,
+                                  integer_t right) noexcept {
+    return left.num < static_cast<integer_t>(right * left.denom);
+  }
+
+  /**
+   * @brief Less than comparison against a whole number.
+   *
+   * @param left Left side integer.
+   * @param right Right side rational.
+   * @return whether relation is satisfied.
+   */
+  friend constexpr bool operator<(integer_t left,
+                                  const rational_t& right) noexcept {
+    return static_cast<integer_t>(left * right.denom) < right.num;
+  }
+
+  /**
+   * @brief Less than or equal to comparison against a whole number.
+   *
+   * @param left Left side rational.
+   * @param right Right side integer.
+   * @return whether relation is satisfied.
+   */
+  friend constexpr bool operator<=(const rational_t& left,
+                                   integer_t right) noexcept {
+    return !(right < left);
+  }
+
+  /**
+   * @brief Less than or equal to comparison against a whole number.
+   *
+   * @param left Left side integer.
+   * @param right Right side rational.
+   * @return whether relation is satisfied.
+   */
+  friend constexpr bool operator<=(integer_t left,
+                                   const rational_t& right) noexcept {
+    return !(right < left);
+  }
+
+  /**
+   * @brief Greater than comparison against a whole number.
+   *
+   * @param left Left side rational.
+   * @param right Right side integer.
+   * @return whether relation is satisfied.
+   */
+  friend constexpr bool operator>(const rational_t& left,
+                                  integer_t right) noexcept {
+    return right < left;
+  }
+
+  /**
+   * @brief Greater than comparison against a whole number.
+   *
+   * @param left Left side integer.
+   * @param right Right side rational.
+   * @return whether relation is satisfied.
+   */
+  friend constexpr bool operator>(integer_t left,
+                                  const rational_t& right) noexcept {
+    return right < left;
+  }
+
+  /**
+   * @brief Greater than or equal to comparison against a whole number.
+   *
+   * @param left Left side rational.
+   * @param right Right side integer.
+   * @return whether relation is satisfied.
+   */
+  friend constexpr bool operator>=(const rational_t& left,
+                                   integer_t right) noexcept {
+    return !(left < right);
+  }
+
+  /**
+   * @brief Greater than or equal to comparison against a whole number.
+   *
+   * @param left Left side integer.
+   * @param right Right side rational.
+   * @return whether relation is satisfied.
+   */
+  friend constexpr bool operator>=(integer_t left,
+                                   const rational_t& right) noexcept {
+    return !(left < right);
+  }
+
+
+  /**
+   * @brief Non-throwing locale-free parse of "num" or "num/denom" text.
+   *
+   * @param first Start of the character range.
+   * @param last One past the end of the character range.
+   * @param value Receives the parsed rational on success.
+   * @param canonical Hint that the text is already reduced with a
+   * positive denominator, which skips the gcd.
+   * @return pointer past the consumed text and an error code, matching
+   * the std::from_chars convention. On failure value is untouched and
+   * ptr equals first.
+   */
+  static std::from_chars_result from_chars(const char* first, const char* last,
+                                           rational_t& value,
+                                           bool canonical = false) noexcept {
+    integer_t num_val = 0;
+    auto result = parse_int(first, last, num_val);
+    if (result.ec != std::errc()) return result;
+    integer_t denom_val = 1;
+    auto ptr = result.ptr;
+    if (ptr != last && *ptr == '/') {
+      result = parse_int(ptr + 1, last, denom_val);
+      if (result.ec != std::errc()) return {first, result.ec};
+      ptr = result.ptr;
+    }
+    if (denom_val == 0) return {first, std::errc::invalid_argument};
+    value.num = num_val;
+    value.denom = denom_val;
+    if (canonical) {
+      if (value.denom < 0) {
+        value.num = static_cast<integer_t>(-value.num);
+        value.denom = static_cast<integer_t>(-value.denom);
+      }
+    } else {
+      value.simplify();
+    }
+    return {ptr, std::errc()};
+  }
+
+  /**
+   * @brief Non-throwing locale-free formatting as "num/denom" text.
+   *
+   * Writes straight into the caller's buffer with none of ostream's
+   * locale or sentry machinery, for report writers emitting rationals by
+   * the million.
+   *
+   * @param first Start of the character range.
+   * @param last One past the end of the character range.
+   * @return pointer past the written text and an error code, matching
+   * the std::to_chars convention. On overflow the buffer contents are
+   * unspecified.
+   */
+  std::to_chars_result to_chars(char* first, char* last) const noexcept {
+    auto result = write_int(first, last, num);
+    if (result.ec != std::errc()) return result;
+    if (result.ptr == last) return {last, std::errc::value_too_large};
+    *result.ptr = '/';
+    return write_int(result.ptr + 1, last, denom);
+  }
+
+  /**
+   * @brief Exact fixed-precision decimal expansion by long division.
+   *
+   * Truncates toward zero, so every emitted digit is exact rather than
+   * the nearest double. Denominators within an eighth of the component
+   * maximum can overflow the remainder scaling.
+   *
+   * @param digits Number of digits after the decimal point.
+   * @return decimal text of this rational.
+   */
+  std::string to_decimal(std::size_t digits) const {
+    char buffer[48];
+    std::string out;
+    if (num < 0) out.push_back('-');
+    const auto mag = iabs(num);
+    const auto whole = write_int(buffer, buffer + sizeof(buffer),
+                                 static_cast<integer_t>(mag / denom));
+    out.append(buffer, whole.ptr);
+    if (digits == 0) return out;
+    out.push_back('.');
+    auto rem = static_cast<integer_t>(mag % denom);
+    for (std::size_t place = 0; place < digits; ++place) {
+      rem = static_cast<integer_t>(rem * 10);
+      out.push_back(static_cast<char>('0' + static_cast<int>(rem / denom)));
+      rem = static_cast<integer_t>(rem % denom);
+    }
+    return out;
+  }
 
   /**
    * @brief Write rational to stream.
@@ -260,5 +1647,116 @@ class rational {
    * @param frac The rational to write.
    * @return out
    */
-  friend std::ostream& operator<<(std::ostream& out, const rational& frac);
+  friend std::ostream& operator<<(std::ostream& out, const rational_t& frac) {
+    return out << frac.num << '/' << frac.denom;
+  }
+
+  /**
+   * @brief Read rational from stream as "num" or "num/denom".
+   *
+   * Sets failbit on malformed input or a zero denominator, leaving frac
+   * untouched.
+   *
+   * @param in The input stream.
+   * @param frac The rational to read into.
+   * @return in
+   */
+  friend std::istream& operator>>(std::istream& in, rational_t& frac) {
+    integer_t num_val = 0;
+    if (!(in >> num_val)) return in;
+    integer_t denom_val = 1;
+    if (in.peek() == '/') {
+      in.get();
+      if (!(in >> denom_val)) return in;
+    }
+    if (denom_val == 0) {
+      in.setstate(std::ios_base::failbit);
+      return in;
+    }
+    frac = rational_t(num_val, denom_val);
+    return in;
+  }
+};
+
+/**
+ * @brief Compact rational for cache-dense workloads. 8 bytes per value.
+ *
+ */
+using rational32 = rational_t<std::int32_t>;
+
+/**
+ * @brief General-purpose rational. 16 bytes per value.
+ *
+ */
+using rational64 = rational_t<std::int64_t>;
+
+/**
+ * @brief Default rational, preserved for existing callers.
+ *
+ */
+using rational = rational_t<std::int64_t>;
+
+#ifdef __SIZEOF_INT128__
+/**
+ * @brief Wide rational with headroom against intermediate overflow.
+ *
+ */
+using rational128 = rational_t<int128_t>;
+#endif
+
+/**
+ * @brief Compile-time rational constant, reduced during translation.
+ *
+ * rational_c<355, 113> evaluates the reducing constructor under constant
+ * evaluation, so the canonical value lands in .rodata and a zero
+ * denominator is a compile error rather than a throw. Tables of
+ * constants built from these cost nothing at startup.
+ *
+ * @tparam Num The numerator.
+ * @tparam Denom The denominator. Must be non-zero. Defaults to 1.
+ */
+template <rational::integer_t Num, rational::integer_t Denom = 1>
+inline constexpr rational rational_c = rational(Num, Denom);
+
+/**
+ * @brief User-defined literals for rational constants.
+ *
+ */
+namespace rational_literals {
+
+/**
+ * @brief Literal rational with the given integer value.
+ *
+ * Quotients of literals, like 7_r / 22_r, stay constexpr end to end and
+ * fold to one canonical constant.
+ *
+ * @param value The literal's digits.
+ * @return rational equal to value.
+ */
+constexpr rational operator""_r(unsigned long long value) {
+  return rational(static_cast<rational::integer_t>(value));
+}
+
+}  // namespace rational_literals
+
+namespace std {
+
+/**
+ * @brief Standard hash support keyed on the canonical component pair.
+ *
+ * @tparam T The integer type of the numerator and denominator.
+ */
+template <class T>
+struct hash<rational_t<T>> {
+  /**
+   * @brief Hash a rational.
+   *
+   * @param frac The rational to hash.
+   * @return size_t hash of frac.
+   */
+  constexpr size_t operator()(const rational_t<T>& frac) const noexcept {
+    return frac.hash_code();
+  }
 };
+
+}  // namespace std
@@ -0,0 +1,174 @@
+/**
+ * @file reduce.h
+ * @author Andrew Wang (siweiw9@gmail.com)
+ * @brief Multi-threaded exact reductions over rational ranges.
+ * @version 0.1
+ * @date 2022-02-26
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#include "rational.h"
+
+/**
+ * @brief Blocked tree reductions: per-thread exact partials combined
+ * pairwise, with simplification deferred while components are small.
+ */
+namespace reduce {
+
+/**
+ * @brief Value type of the iterated range.
+ *
+ */
+template <class Iter>
+using value_t = typename std::iterator_traits<Iter>::value_type;
+
+/**
+ * @brief Smallest block worth a thread; below this, spawn overhead wins.
+ *
+ */
+constexpr std::size_t min_block = 1024;
+
+/**
+ * @brief Component bound under which an unreduced product cannot
+ * overflow: the square root of the component maximum.
+ *
+ * @tparam T The integer type of the components.
+ * @return largest safe component magnitude.
+ */
+template <class T>
+constexpr T safe_bound() {
+  constexpr auto bits = 8 * sizeof(T) - 1;
+  return static_cast<T>(static_cast<T>(1) << (bits / 2));
+}
+
+/**
+ * @brief Add into an accumulator, deferring the gcd while safe.
+ *
+ * While every component is below the half-width bound, the raw
+ * cross-multiply cannot overflow and the gcd is skipped entirely; once
+ * the accumulator or operand grows past it, fall back to the reducing
+ * two-gcd path.
+ *
+ * @param acc The accumulator.
+ * @param value The added rational.
+ */
+template <class T>
+void add_deferred(rational_t<T>& acc, const rational_t<T>& value) {
+  const auto bound = safe_bound<T>();
+  if (acc.denominator() < bound && value.denominator() < bound &&
+      acc.numerator() < bound && acc.numerator() > -bound &&
+      value.numerator() < bound && value.numerator() > -bound) {
+    acc.add_unreduced(value);
+  } else {
+    acc.normalize();
+    acc += value;
+  }
+}
+
+/**
+ * @brief Multiply into an accumulator, deferring the gcd while safe.
+ *
+ * @param acc The accumulator.
+ * @param value The multiplied rational.
+ */
+template <class T>
+void mul_deferred(rational_t<T>& acc, const rational_t<T>& value) {
+  const auto bound = safe_bound<T>();
+  if (acc.denominator() < bound && value.denominator() < bound &&
+      acc.numerator() < bound && acc.numerator() > -bound &&
+      value.numerator() < bound && value.numerator() > -bound) {
+    acc.mul_unreduced(value);
+  } else {
+    acc.normalize();
+    acc *= value;
+  }
+}
+
+/**
+ * @brief Exact multi-threaded sum of a rational range.
+ *
+ * The range splits into per-thread blocks reduced independently with
+ * deferred simplification; the partials then combine pairwise in a
+ * log-depth tree. Exactness does not depend on order, so the result
+ * matches the serial sum.
+ *
+ * @param first Start of the range.
+ * @param last One past the end of the range.
+ * @param nthreads Worker count; zero picks the hardware concurrency.
+ * @return exact sum, canonical. Zero for an empty range.
+ */
+template <class Iter>
+value_t<Iter> sum(Iter first, Iter last, unsigned nthreads = 0) {
+  using rational_v = value_t<Iter>;
+  const auto count = static_cast<std::size_t>(std::distance(first, last));
+  if (nthreads == 0) nthreads = std::max(1u, std::thread::hardware_concurrency());
+  const auto workers = static_cast<std::size_t>(
+      std::min<std::size_t>(nthreads, std::max<std::size_t>(count / min_block, 1)));
+  std::vector<rational_v> partials(workers, rational_v(0));
+  std::vector<std::thread> pool;
+  pool.reserve(workers);
+  for (std::size_t worker = 0; worker < workers; ++worker) {
+    const auto begin = first + static_cast<std::ptrdiff_t>(worker * count / workers);
+    const auto end = first + static_cast<std::ptrdiff_t>((worker + 1) * count / workers);
+    pool.emplace_back([begin, end, worker, &partials]() {
+      auto acc = rational_v(0);
+      for (auto it = begin; it != end; ++it) add_deferred(acc, *it);
+      partials[worker] = acc.normalize();
+    });
+  }
+  for (auto& thread : pool) thread.join();
+  for (std::size_t step = 1; step < workers; step *= 2) {
+    for (std::size_t i = 0; i + step < workers; i += 2 * step) {
+      partials[i] += partials[i + step];
+    }
+  }
+  return partials.front();
+}
+
+/**
+ * @brief Exact multi-threaded product of a rational range.
+ *
+ * Same blocking and combine scheme as sum.
+ *
+ * @param first Start of the range.
+ * @param last One past the end of the range.
+ * @param nthreads Worker count; zero picks the hardware concurrency.
+ * @return exact product, canonical. One for an empty range.
+ */
+template <class Iter>
+value_t<Iter> product(Iter first, Iter last, unsigned nthreads = 0) {
+  using rational_v = value_t<Iter>;
+  const auto count = static_cast<std::size_t>(std::distance(first, last));
+  if (nthreads == 0) nthreads = std::max(1u, std::thread::hardware_concurrency());
+  const auto workers = static_cast<std::size_t>(
+      std::min<std::size_t>(nthreads, std::max<std::size_t>(count / min_block, 1)));
+  std::vector<rational_v> partials(workers, rational_v(1));
+  std::vector<std::thread> pool;
+  pool.reserve(workers);
+  for (std::size_t worker = 0; worker < workers; ++worker) {
+    const auto begin = first + static_cast<std::ptrdiff_t>(worker * count / workers);
+    const auto end = first + static_cast<std::ptrdiff_t>((worker + 1) * count / workers);
+    pool.emplace_back([begin, end, worker, &partials]() {
+      auto acc = rational_v(1);
+      for (auto it = begin; it != end; ++it) mul_deferred(acc, *it);
+      partials[worker] = acc.normalize();
+    });
+  }
+  for (auto& thread : pool) thread.join();
+  for (std::size_t step = 1; step < workers; step *= 2) {
+    for (std::size_t i = 0; i + step < workers; i += 2 * step) {
+      partials[i] *= partials[i + step];
+    }
+  }
+  return partials.front();
+}
+
+}  // namespace reduce
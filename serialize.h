@@ -0,0 +1,156 @@
+/**
+ * @file serialize.h
+ * @author Andrew Wang (siweiw9@gmail.com)
+ * @brief Zero-copy binary serialization for arrays of rationals.
+ * @version 0.1
+ * @date 2022-02-26
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "rational.h"
+
+/**
+ * @brief Fixed-layout binary reader and writer helpers.
+ *
+ * A file of packed records is byte-identical to the in-memory array of
+ * rationals, so a reader may memory-map it and use the mapping in place
+ * instead of parsing. Records are native-endian; files are not portable
+ * across byte orders.
+ */
+namespace serialize {
+
+/**
+ * @brief Layout preconditions for treating file bytes as rationals.
+ *
+ * @tparam T The integer type of the components.
+ */
+template <class T>
+constexpr void check_layout() {
+  static_assert(std::is_trivially_copyable<rational_t<T>>::value,
+                "rational_t must be trivially copyable to serialize.");
+  static_assert(sizeof(rational_t<T>) == 2 * sizeof(T),
+                "rational_t must be exactly its two components.");
+  static_assert(sizeof(typename rational_t<T>::packed) ==
+                    sizeof(rational_t<T>),
+                "packed must mirror the rational_t layout.");
+}
+
+/**
+ * @brief Non-owning view over rationals mapped from raw bytes.
+ *
+ * Minimal stand-in for std::span<const rational_t<T>> until the repo
+ * moves past C++17.
+ *
+ * @tparam T The integer type of the components.
+ */
+template <class T>
+struct record_view {
+  const rational_t<T>* records;
+  std::size_t count;
+
+  /**
+   * @brief Number of records viewed.
+   *
+   * @return record count.
+   */
+  std::size_t size() const { return count; }
+
+  /**
+   * @brief First record, for range-for support.
+   *
+   * @return pointer to the first record.
+   */
+  const rational_t<T>* begin() const { return records; }
+
+  /**
+   * @brief One past the last record, for range-for support.
+   *
+   * @return pointer past the last record.
+   */
+  const rational_t<T>* end() const { return records + count; }
+
+  /**
+   * @brief Record at the given position. Unchecked.
+   *
+   * @param index The record position.
+   * @return the viewed rational.
+   */
+  const rational_t<T>& operator[](std::size_t index) const {
+    return records[index];
+  }
+};
+
+/**
+ * @brief Write records as flat packed bytes.
+ *
+ * @param out The output stream, opened in binary mode.
+ * @param values The rationals to write.
+ * @param count Number of rationals.
+ */
+template <class T>
+void write_records(std::ostream& out, const rational_t<T>* values,
+                   std::size_t count) {
+  check_layout<T>();
+  out.write(reinterpret_cast<const char*>(values),
+            static_cast<std::streamsize>(count * sizeof(rational_t<T>)));
+}
+
+/**
+ * @brief Write a vector of records as flat packed bytes.
+ *
+ * @param out The output stream, opened in binary mode.
+ * @param values The rationals to write.
+ */
+template <class T>
+void write_records(std::ostream& out, const std::vector<rational_t<T>>& values) {
+  write_records(out, values.data(), values.size());
+}
+
+/**
+ * @brief Read every remaining record from a stream into a vector.
+ *
+ * For use when a copy is wanted; map_records is the zero-copy path.
+ *
+ * @param in The input stream, opened in binary mode.
+ * @return vector of the records read.
+ */
+template <class T>
+std::vector<rational_t<T>> read_records(std::istream& in) {
+  check_layout<T>();
+  std::vector<rational_t<T>> values;
+  typename rational_t<T>::packed record;
+  while (in.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+    values.push_back(rational_t<T>::from_packed(record));
+  }
+  return values;
+}
+
+/**
+ * @brief View a buffer of packed records in place, with no copy.
+ *
+ * The buffer, typically a memory-mapped file, must stay alive for the
+ * lifetime of the view and must be aligned for T.
+ *
+ * @param data Start of the packed bytes.
+ * @param bytes Size of the buffer in bytes.
+ * @return non-owning view of the records.
+ */
+template <class T>
+record_view<T> map_records(const void* data, std::size_t bytes) {
+  check_layout<T>();
+  if (bytes % sizeof(rational_t<T>) != 0) {
+    throw std::invalid_argument("Buffer is not a whole number of records.");
+  }
+  return {static_cast<const rational_t<T>*>(data),
+          bytes / sizeof(rational_t<T>)};
+}
+
+}  // namespace serialize
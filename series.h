@@ -0,0 +1,286 @@
+/**
+ * @file series.h
+ * @author Andrew Wang (siweiw9@gmail.com)
+ * @brief Common-denominator container for aligned rational time series.
+ * @version 0.1
+ * @date 2022-02-26
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "rational.h"
+
+/**
+ * @brief Sequence of rationals sharing one denominator.
+ *
+ * Stores the common base once plus a contiguous numerator array, so a
+ * tick series in 1/10000ths costs one integer per sample. Elementwise
+ * combination against a series on the same base is a plain integer
+ * loop with no gcd and no per-element division, which vectorizes;
+ * mismatched bases rebase through the least common multiple first.
+ *
+ * Individual elements are not kept reduced against the base; at() and
+ * to_rationals() reduce on the way out.
+ *
+ * @tparam T The integer type of the numerators and the base.
+ */
+template <class T>
+class rational_series {
+ private:
+  T base;
+  std::vector<T> ticks;
+
+  /**
+   * @brief Greatest common divisor of two non-negative values.
+   *
+   * @param first The first integer.
+   * @param second The second integer.
+   * @return gcd(first, second)
+   */
+  static constexpr T gcd_of(T first, T second) noexcept {
+    while (second != 0) {
+      const auto rem = static_cast<T>(first % second);
+      first = second;
+      second = rem;
+    }
+    return first;
+  }
+
+  /**
+   * @brief Scale every numerator and the base by an integer factor.
+   *
+   * @param factor The rebasing factor. Must be positive.
+   */
+  void upscale(T factor) {
+    if (factor == 1) return;
+    for (auto& tick : ticks) tick = static_cast<T>(tick * factor);
+    base = static_cast<T>(base * factor);
+  }
+
+ public:
+  /**
+   * @brief Construct an empty series over a common denominator.
+   *
+   * @param denominator The shared base. Must be positive.
+   */
+  explicit rational_series(T denominator) : base(denominator) {
+    if (base <= 0) {
+      throw std::invalid_argument("Base must be positive.");
+    }
+  }
+
+  /**
+   * @brief Construct a series holding the given rationals.
+   *
+   * @param denominator The shared base. Must be positive and divisible
+   * by every element's denominator.
+   * @param values The rationals to store.
+   */
+  rational_series(T denominator, const std::vector<rational_t<T>>& values)
+      : rational_series(denominator) {
+    ticks.reserve(values.size());
+    for (const auto& frac : values) push_back(frac);
+  }
+
+  /**
+   * @brief The shared denominator.
+   *
+   * @return the base.
+   */
+  T denominator() const noexcept { return base; }
+
+  /**
+   * @brief Number of samples held.
+   *
+   * @return sample count.
+   */
+  std::size_t size() const noexcept { return ticks.size(); }
+
+  /**
+   * @brief Numerator of the sample at the given position, over the base.
+   *
+   * @param index The sample position.
+   * @return numerator in base units.
+   */
+  T numerator(std::size_t index) const { return ticks.at(index); }
+
+  /**
+   * @brief Append a sample given directly in base units. No gcd.
+   *
+   * @param numerator_ticks The numerator over the shared base.
+   */
+  void push_back(T numerator_ticks) { ticks.push_back(numerator_ticks); }
+
+  /**
+   * @brief Append a rational sample, rescaling it onto the base.
+   *
+   * @param frac The sample. Its denominator must divide the base.
+   */
+  void push_back(const rational_t<T>& frac) {
+    if (base % frac.denominator() != 0) {
+      throw std::invalid_argument("Denominator does not divide the base.");
+    }
+    ticks.push_back(
+        static_cast<T>(frac.numerator() * (base / frac.denominator())));
+  }
+
+  /**
+   * @brief Materialize the sample at the given position, reduced.
+   *
+   * @param index The sample position.
+   * @return rational value of the sample.
+   */
+  rational_t<T> at(std::size_t index) const {
+    return rational_t<T>(ticks.at(index), base);
+  }
+
+  /**
+   * @brief Materialize every sample as a reduced rational.
+   *
+   * @return vector of the sample values.
+   */
+  std::vector<rational_t<T>> to_rationals() const {
+    std::vector<rational_t<T>> values;
+    values.reserve(ticks.size());
+    for (const auto tick : ticks) values.emplace_back(tick, base);
+    return values;
+  }
+
+  /**
+   * @brief Elementwise addition of another series.
+   *
+   * Matching bases reduce to one integer add per sample; otherwise both
+   * series rebase onto the least common multiple first.
+   *
+   * @param other The added series. Must have the same length.
+   * @return this
+   */
+  rational_series& operator+=(const rational_series& other) {
+    if (ticks.size() != other.ticks.size()) {
+      throw std::invalid_argument("Series lengths must match.");
+    }
+    if (base == other.base) {
+      for (std::size_t i = 0; i < ticks.size(); ++i) {
+        ticks[i] = static_cast<T>(ticks[i] + other.ticks[i]);
+      }
+      return *this;
+    }
+    const auto div = gcd_of(base, other.base);
+    const auto scale_other = static_cast<T>(base / div);
+    upscale(static_cast<T>(other.base / div));
+    for (std::size_t i = 0; i < ticks.size(); ++i) {
+      ticks[i] = static_cast<T>(ticks[i] + other.ticks[i] * scale_other);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Elementwise subtraction of another series.
+   *
+   * @param other The subtracted series. Must have the same length.
+   * @return this
+   */
+  rational_series& operator-=(const rational_series& other) {
+    if (ticks.size() != other.ticks.size()) {
+      throw std::invalid_argument("Series lengths must match.");
+    }
+    if (base == other.base) {
+      for (std::size_t i = 0; i < ticks.size(); ++i) {
+        ticks[i] = static_cast<T>(ticks[i] - other.ticks[i]);
+      }
+      return *this;
+    }
+    const auto div = gcd_of(base, other.base);
+    const auto scale_other = static_cast<T>(base / div);
+    upscale(static_cast<T>(other.base / div));
+    for (std::size_t i = 0; i < ticks.size(); ++i) {
+      ticks[i] = static_cast<T>(ticks[i] - other.ticks[i] * scale_other);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Scale every sample by one rational factor.
+   *
+   * One gcd for the whole series: the factor reduces against the base
+   * once, then the numerators see a single integer multiply each.
+   *
+   * @param factor The scale factor.
+   * @return this
+   */
+  rational_series& scale(const rational_t<T>& factor) {
+    const auto div = gcd_of(base, factor.numerator() < 0
+                                      ? static_cast<T>(-factor.numerator())
+                                      : factor.numerator());
+    const auto num_scale = static_cast<T>(factor.numerator() / div);
+    base = static_cast<T>(base / div);
+    base = static_cast<T>(base * factor.denominator());
+    for (auto& tick : ticks) tick = static_cast<T>(tick * num_scale);
+    return *this;
+  }
+
+  /**
+   * @brief Elementwise less-than against another series.
+   *
+   * @param other The compared series. Must have the same length.
+   * @return flags, 1 where this[i] < other[i] and 0 elsewhere.
+   */
+  std::vector<std::uint8_t> less(const rational_series& other) const {
+    if (ticks.size() != other.ticks.size()) {
+      throw std::invalid_argument("Series lengths must match.");
+    }
+    std::vector<std::uint8_t> mask(ticks.size());
+    if (base == other.base) {
+      for (std::size_t i = 0; i < ticks.size(); ++i) {
+        mask[i] = ticks[i] < other.ticks[i] ? 1 : 0;
+      }
+      return mask;
+    }
+    const auto div = gcd_of(base, other.base);
+    const auto scale_this = static_cast<T>(other.base / div);
+    const auto scale_other = static_cast<T>(base / div);
+    for (std::size_t i = 0; i < ticks.size(); ++i) {
+      mask[i] = ticks[i] * scale_this < other.ticks[i] * scale_other ? 1 : 0;
+    }
+    return mask;
+  }
+
+  /**
+   * @brief Exact elementwise equality.
+   *
+   * @param left Left side series.
+   * @param right Right side series.
+   * @return whether every pair of samples is equal in value.
+   */
+  friend bool operator==(const rational_series& left,
+                         const rational_series& right) {
+    if (left.ticks.size() != right.ticks.size()) return false;
+    if (left.base == right.base) return left.ticks == right.ticks;
+    const auto div = gcd_of(left.base, right.base);
+    const auto scale_left = static_cast<T>(right.base / div);
+    const auto scale_right = static_cast<T>(left.base / div);
+    for (std::size_t i = 0; i < left.ticks.size(); ++i) {
+      if (left.ticks[i] * scale_left != right.ticks[i] * scale_right) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Elementwise inequality.
+   *
+   * @param left Left side series.
+   * @param right Right side series.
+   * @return whether any pair of samples differs in value.
+   */
+  friend bool operator!=(const rational_series& left,
+                         const rational_series& right) {
+    return !(left == right);
+  }
+};
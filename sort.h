@@ -0,0 +1,82 @@
+/**
+ * @file sort.h
+ * @author Andrew Wang (siweiw9@gmail.com)
+ * @brief Approximation-keyed hybrid sort for large rational arrays.
+ * @version 0.1
+ * @date 2022-02-26
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "rational.h"
+
+/**
+ * @brief Ordering helpers exploiting the double approximation.
+ *
+ */
+namespace sort {
+
+/**
+ * @brief Sort a rational range by value.
+ *
+ * Comparing rationals exactly costs two multiplications; comparing their
+ * value() doubles costs one branch. Rounding to double is monotone, so a
+ * strict double inequality already decides the exact order — the range
+ * sorts on extracted double keys first, and only runs of elements whose
+ * keys tie re-sort with the exact cross-multiplying comparison. On
+ * realistic data nearly every comparison resolves on the key.
+ *
+ * @param first Start of the range.
+ * @param last One past the end of the range.
+ */
+template <class Iter>
+void rationals(Iter first, Iter last) {
+  using rational_v = typename std::iterator_traits<Iter>::value_type;
+  using keyed_t = std::pair<double, rational_v>;
+  const auto count = static_cast<std::size_t>(std::distance(first, last));
+  if (count < 2) return;
+  std::vector<keyed_t> keyed;
+  keyed.reserve(count);
+  for (auto it = first; it != last; ++it) keyed.emplace_back(it->value(), *it);
+  std::sort(keyed.begin(), keyed.end(),
+            [](const keyed_t& left, const keyed_t& right) {
+              return left.first < right.first;
+            });
+  const auto exact = [](const keyed_t& left, const keyed_t& right) {
+    return left.second < right.second;
+  };
+  std::size_t run = 0;
+  for (std::size_t i = 1; i < count; ++i) {
+    if (keyed[i].first > keyed[run].first) {
+      if (i - run > 1) {
+        std::sort(keyed.begin() + static_cast<std::ptrdiff_t>(run),
+                  keyed.begin() + static_cast<std::ptrdiff_t>(i), exact);
+      }
+      run = i;
+    }
+  }
+  if (count - run > 1) {
+    std::sort(keyed.begin() + static_cast<std::ptrdiff_t>(run), keyed.end(),
+              exact);
+  }
+  for (auto& entry : keyed) *first++ = entry.second;
+}
+
+/**
+ * @brief Sort a vector of rationals by value.
+ *
+ * @param values The sorted vector.
+ */
+template <class T>
+void rationals(std::vector<rational_t<T>>& values) {
+  rationals(values.begin(), values.end());
+}
+
+}  // namespace sort
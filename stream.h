@@ -0,0 +1,160 @@
+/**
+ * @file stream.h
+ * @author Andrew Wang (siweiw9@gmail.com)
+ * @brief Streaming aggregation over rational datasets larger than RAM.
+ * @version 0.1
+ * @date 2022-02-26
+ *
+ * @copyright Copyright (c) 2022
+ *
+ */
+#pragma once
+#include <cstddef>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "hash_map.h"
+#include "rational.h"
+#include "reduce.h"
+#include "serialize.h"
+
+/**
+ * @brief Double-buffered block reader and out-of-core folds.
+ *
+ * Files in the packed binary layout of serialize.h stream through two
+ * buffers: a loader thread fills the next block while the caller's fold
+ * runs over the current one, so computation overlaps I/O and the pass is
+ * bound by whichever is slower — never their sum. Nothing beyond the two
+ * blocks is ever resident.
+ */
+namespace stream {
+
+/**
+ * @brief Default records per block: big enough to amortize a read
+ * syscall, small enough to stay cache-friendly.
+ *
+ */
+constexpr std::size_t block_records = std::size_t(1) << 16;
+
+/**
+ * @brief Fold every record of a packed stream, one block at a time.
+ *
+ * The fold callback receives a pointer to a block of canonical rationals
+ * and its length; it runs on the calling thread while the loader thread
+ * reads ahead into the other buffer.
+ *
+ * @param in The input stream of packed records, opened in binary mode.
+ * @param fold Callback taking (const rational_t<T>*, std::size_t).
+ * @param block Records per block.
+ * @return total number of records folded.
+ */
+template <class T, class Fold>
+std::size_t for_each_block(std::istream& in, Fold&& fold,
+                           std::size_t block = block_records) {
+  serialize::check_layout<T>();
+  std::vector<rational_t<T>> front(block, rational_t<T>(0));
+  std::vector<rational_t<T>> back(block, rational_t<T>(0));
+  const auto load = [&in](std::vector<rational_t<T>>& buffer) {
+    in.read(reinterpret_cast<char*>(buffer.data()),
+            static_cast<std::streamsize>(buffer.size() * sizeof(rational_t<T>)));
+    return static_cast<std::size_t>(in.gcount()) / sizeof(rational_t<T>);
+  };
+  auto count = load(front);
+  std::size_t total = 0;
+  while (count != 0) {
+    std::size_t ahead = 0;
+    std::thread loader([&load, &back, &ahead]() { ahead = load(back); });
+    fold(front.data(), count);
+    total += count;
+    loader.join();
+    front.swap(back);
+    count = ahead;
+  }
+  return total;
+}
+
+/**
+ * @brief Exact sum of a packed stream with per-block deferred reduction.
+ *
+ * Inside a block the accumulator adds through reduce::add_deferred,
+ * skipping the gcd while components stay below the half-width bound, and
+ * normalizes once per block.
+ *
+ * @param in The input stream of packed records, opened in binary mode.
+ * @param block Records per block.
+ * @return exact sum of every record. Zero for an empty stream.
+ */
+template <class T>
+rational_t<T> sum(std::istream& in, std::size_t block = block_records) {
+  auto total = rational_t<T>(0);
+  for_each_block<T>(
+      in,
+      [&total](const rational_t<T>* values, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+          reduce::add_deferred(total, values[i]);
+        }
+        total.normalize();
+      },
+      block);
+  return total;
+}
+
+/**
+ * @brief Smallest and largest record of a packed stream.
+ *
+ * @param in The input stream of packed records, opened in binary mode.
+ * @param block Records per block.
+ * @return the (minimum, maximum) pair. (0, 0) for an empty stream.
+ */
+template <class T>
+std::pair<rational_t<T>, rational_t<T>> minmax(
+    std::istream& in, std::size_t block = block_records) {
+  auto lowest = rational_t<T>(0);
+  auto highest = rational_t<T>(0);
+  bool seeded = false;
+  for_each_block<T>(
+      in,
+      [&lowest, &highest, &seeded](const rational_t<T>* values,
+                                   std::size_t count) {
+        std::size_t start = 0;
+        if (!seeded) {
+          lowest = values[0];
+          highest = values[0];
+          seeded = true;
+          start = 1;
+        }
+        for (std::size_t i = start; i < count; ++i) {
+          if (values[i] < lowest) lowest = values[i];
+          if (highest < values[i]) highest = values[i];
+        }
+      },
+      block);
+  return {lowest, highest};
+}
+
+/**
+ * @brief Number of distinct values in a packed stream.
+ *
+ * Canonical form makes distinctness a set membership test, served by the
+ * open-addressed rational_map.
+ *
+ * @param in The input stream of packed records, opened in binary mode.
+ * @param block Records per block.
+ * @return count of distinct record values.
+ */
+template <class T>
+std::size_t count_distinct(std::istream& in,
+                           std::size_t block = block_records) {
+  rational_map<T, bool> seen;
+  for_each_block<T>(
+      in,
+      [&seen](const rational_t<T>* values, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) seen[values[i]] = true;
+      },
+      block);
+  return seen.size();
+}
+
+}  // namespace stream
@@ -8,13 +8,34 @@
  * @copyright Copyright (c) 2022
  *
  */
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <limits>
 #include <numeric>
 #include <sstream>
 #include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <utility>
 
+#include <unordered_map>
+
+#include "batch.h"
+#include "checked.h"
+#include "expr.h"
+#include "hash_map.h"
+#include "intern.h"
+#include "linalg.h"
+#include "parallel.h"
+#include "serialize.h"
+#include "series.h"
+#include "sort.h"
+#include "stream.h"
+#include "big_rational.h"
 #include "rational.h"
+#include "reduce.h"
 using std::abs;
 using std::cerr;
 using std::cout;
@@ -40,6 +61,35 @@ void decrement();
 void op_equality();
 void op_compare();
 void op_write();
+void component_widths();
+void lazy_normalize();
+void batch_kernels();
+void add_structured_denoms();
+void big_rational_ops();
+void trivial_copy();
+void op_integer_mixed();
+void hashing();
+void compare_wide();
+void op_read();
+void parse_chars();
+void binary_records();
+void approximate();
+void from_double();
+void parallel_reduce();
+void series_ops();
+void expr_fusion();
+void checked_ops();
+void linear_algebra();
+void literal_constants();
+void hybrid_sort();
+void intern_handles();
+void stats_report();
+void integer_pow();
+void format_chars();
+void from_value_recovery();
+void stream_folds();
+void inplace_mutators();
+void parallel_transforms();
 }  // namespace test
 
 template <typename S, typename T>
@@ -81,6 +131,35 @@ int main() {
   test::op_equality();
   test::op_compare();
   test::op_write();
+  test::component_widths();
+  test::lazy_normalize();
+  test::batch_kernels();
+  test::add_structured_denoms();
+  test::big_rational_ops();
+  test::trivial_copy();
+  test::op_integer_mixed();
+  test::hashing();
+  test::compare_wide();
+  test::op_read();
+  test::parse_chars();
+  test::binary_records();
+  test::approximate();
+  test::from_double();
+  test::parallel_reduce();
+  test::series_ops();
+  test::expr_fusion();
+  test::checked_ops();
+  test::linear_algebra();
+  test::literal_constants();
+  test::hybrid_sort();
+  test::intern_handles();
+  test::stats_report();
+  test::integer_pow();
+  test::format_chars();
+  test::from_value_recovery();
+  test::stream_folds();
+  test::inplace_mutators();
+  test::parallel_transforms();
 
   {
     cout << "Approximation of Euler's constant via power series.\n";
@@ -291,3 +370,809 @@ void test::op_write() {
   whole_ss << whole;
   assert_equals("-9/1", whole_ss.str());
 }
+
+void test::component_widths() {
+  cout << "Test: Component Widths\n";
+
+  const rational32 narrow(6, -8);
+  assert_equals(-3, narrow.numerator());
+  assert_equals(4, narrow.denominator());
+  assert_true(sizeof(rational32) == 2 * sizeof(std::int32_t));
+
+#ifdef __SIZEOF_INT128__
+  const rational128 wide(rational128::integer_t(1) << 80, 1 << 4);
+  assert_true(wide.numerator() == rational128::integer_t(1) << 76);
+  assert_true(wide.denominator() == 1);
+#endif
+}
+
+void test::lazy_normalize() {
+  cout << "Test: Lazy Normalize\n";
+
+  rational raw(rational::unreduced, 4, 6);
+  assert_equals(4, raw.numerator());
+  assert_equals(6, raw.denominator());
+  raw.normalize();
+  assert_equals(2, raw.numerator());
+  assert_equals(3, raw.denominator());
+
+  rational lazy(0);
+  rational eager(0);
+  for (rational::integer_t denom = 1; denom <= 6; ++denom) {
+    lazy.add_unreduced(rational(1, denom));
+    eager += rational(1, denom);
+  }
+  lazy.normalize();
+  assert_equals(eager.numerator(), lazy.numerator());
+  assert_equals(eager.denominator(), lazy.denominator());
+
+  rational prod(rational::unreduced, 3, 9);
+  prod.mul_unreduced(rational(2, 5)).div_unreduced(rational(7, 4)).normalize();
+  assert_equals(8, prod.numerator());
+  assert_equals(105, prod.denominator());
+}
+
+void test::batch_kernels() {
+  cout << "Test: Batch Kernels\n";
+
+  batch::soa<std::int64_t> left;
+  batch::soa<std::int64_t> right;
+  for (rational::integer_t denom = 1; denom <= 8; ++denom) {
+    left.push_back(rational(1, denom));
+    right.push_back(rational(denom, denom + 1));
+  }
+
+  batch::soa<std::int64_t> sum;
+  batch::add(sum, left, right);
+  batch::normalize(sum);
+  for (std::size_t i = 0; i < sum.size(); ++i) {
+    const auto expected = left.at(i) + right.at(i);
+    assert_equals(expected.numerator(), sum.at(i).numerator());
+    assert_equals(expected.denominator(), sum.at(i).denominator());
+  }
+
+  batch::soa<std::int64_t> prod;
+  batch::mul(prod, left, right);
+  batch::normalize(prod);
+  for (std::size_t i = 0; i < prod.size(); ++i) {
+    const auto expected = left.at(i) * right.at(i);
+    assert_equals(expected.numerator(), prod.at(i).numerator());
+    assert_equals(expected.denominator(), prod.at(i).denominator());
+  }
+
+  std::vector<std::uint8_t> mask;
+  batch::less(mask, left, right);
+  for (std::size_t i = 0; i < mask.size(); ++i) {
+    assert_equals(left.at(i) < right.at(i) ? 1 : 0, int(mask[i]));
+  }
+}
+
+void test::add_structured_denoms() {
+  cout << "Test: Add Structured Denoms\n";
+
+  // Shared factors between denominators are divided out before the
+  // cross-multiply, so this no longer overflows at denom products > 2^63.
+  const rational::integer_t big = 4000000000;
+  const auto sum = rational(1, big) + rational(1, big);
+  assert_equals(1, sum.numerator());
+  assert_equals(big / 2, sum.denominator());
+
+  const auto diff = rational(3, big) - rational(1, big);
+  assert_equals(1, diff.numerator());
+  assert_equals(big / 2, diff.denominator());
+
+  const auto zero = rational(-7, 10) + rational(7, 10);
+  assert_equals(0, zero.numerator());
+  assert_equals(1, zero.denominator());
+
+  const auto coprime = rational(2, 9) + rational(3, 8);
+  assert_equals(43, coprime.numerator());
+  assert_equals(72, coprime.denominator());
+}
+
+void test::big_rational_ops() {
+  cout << "Test: Big Rational\n";
+
+  big_rational small(3, 4);
+  small *= big_rational(bigint(2), bigint(-6));
+  assert_true(small == big_rational(bigint(-1), bigint(4)));
+  assert_true(small.numerator().is_small());
+  stringstream small_ss;
+  small_ss << small;
+  assert_equals("-1/4", small_ss.str());
+
+  // 4e9 squared overflows int64; the components promote to heap limbs.
+  big_rational wide(4000000000);
+  wide *= wide;
+  assert_true(!wide.numerator().is_small());
+  stringstream wide_ss;
+  wide_ss << wide;
+  assert_equals("16000000000000000000/1", wide_ss.str());
+  assert_equals(1.6e19, wide.value(), 1e10);
+
+  // Power series for e far past the int64 factorial cliff.
+  big_rational approx_e(1);
+  bigint fac(1);
+  for (std::int64_t denom = 1; denom < 30; ++denom) {
+    fac *= bigint(denom);
+    approx_e += big_rational(bigint(1), fac);
+  }
+  assert_true(!approx_e.denominator().is_small());
+  assert_equals(2.718281828, approx_e.value(), 1e-9);
+
+  const auto diff = wide - big_rational(1);
+  assert_true(diff < wide);
+  assert_true(wide > diff);
+  assert_true(diff >= diff);
+}
+
+void test::trivial_copy() {
+  cout << "Test: Trivial Copy\n";
+
+  assert_true(std::is_trivially_copyable<rational>::value);
+  assert_true(std::is_trivially_copyable<rational32>::value);
+  assert_true(std::is_nothrow_copy_constructible<rational>::value);
+  assert_true(std::is_nothrow_move_assignable<rational>::value);
+
+  const rational frac(21, -14);
+  auto copy = frac;
+  const rational moved(std::move(copy));
+  assert_equals(-3, moved.numerator());
+  assert_equals(2, moved.denominator());
+}
+
+void test::op_integer_mixed() {
+  cout << "Test: Integer Mixed\n";
+
+  rational frac(3, 4);
+  frac += 2;
+  assert_equals(11, frac.numerator());
+  assert_equals(4, frac.denominator());
+  frac -= 3;
+  assert_equals(-1, frac.numerator());
+  assert_equals(4, frac.denominator());
+  frac *= -6;
+  assert_equals(3, frac.numerator());
+  assert_equals(2, frac.denominator());
+  frac /= -9;
+  assert_equals(-1, frac.numerator());
+  assert_equals(6, frac.denominator());
+
+  const rational base(5, 6);
+  assert_true(base + 1 == rational(11, 6));
+  assert_true(2 + base == rational(17, 6));
+  assert_true(base - 1 == rational(-1, 6));
+  assert_true(1 - base == rational(1, 6));
+  assert_true(base * 3 == rational(5, 2));
+  assert_true(-2 * base == rational(-5, 3));
+  assert_true(base / 5 == rational(1, 6));
+  assert_true(5 / base == rational(6, 1));
+
+  assert_true(rational(7) == 7);
+  assert_true(7 == rational(7));
+  assert_true(base != 1);
+  assert_true(base < 1);
+  assert_true(0 < base);
+  assert_true(base <= 1);
+  assert_true(base >= 0);
+  assert_true(1 > base);
+  assert_true(rational(-9, 2) < -4);
+}
+
+void test::hashing() {
+  cout << "Test: Hashing\n";
+
+  const rational canon(9, 16);
+  const rational same(-18, -32);
+  assert_true(canon.hash_code() == same.hash_code());
+  assert_true(std::hash<rational>()(canon) == canon.hash_code());
+  assert_true(canon.hash_code() != rational(16, 9).hash_code());
+
+  std::unordered_map<rational, int> memo;
+  memo[rational(1, 2)] = 1;
+  memo[rational(2, 4)] = 2;
+  assert_equals(std::size_t(1), memo.size());
+  assert_equals(2, memo[rational(1, 2)]);
+
+  rational_map<rational::integer_t, int> table;
+  assert_true(table.empty());
+  for (rational::integer_t denom = 1; denom <= 100; ++denom) {
+    table[rational(1, denom)] = static_cast<int>(denom);
+  }
+  assert_equals(std::size_t(100), table.size());
+  assert_true(table.contains(rational(1, 42)));
+  assert_true(table.contains(rational(2, 84)));
+  assert_equals(21, *table.find(rational(2, 42)));
+  assert_true(table.find(rational(2, 3)) == nullptr);
+  table.clear();
+  assert_true(table.empty());
+}
+
+void test::compare_wide() {
+  cout << "Test: Compare Wide\n";
+
+  // Components past 2^31 used to overflow the 64-bit cross-multiply.
+  const rational lo(4611686018427387901, 4611686018427387903);
+  const rational hi(4611686018427387902, 4611686018427387903);
+  assert_true(lo < hi);
+  assert_true(hi > lo);
+  assert_true(lo.compare(hi) < 0);
+  assert_true(hi.compare(hi) == 0);
+  assert_true(lo < 1 && hi < 1);
+  assert_true(-hi < -lo);
+
+#ifdef __SIZEOF_INT128__
+  // 128-bit components exercise the continued-fraction fallback.
+  const rational128 third(1, 3);
+  const rational128 two_fifths(2, 5);
+  assert_true(third < two_fifths);
+  assert_true(third.compare(third) == 0);
+  assert_true(-two_fifths < -third);
+  const rational128 wide_lo(rational128::integer_t(1) << 90,
+                            (rational128::integer_t(1) << 90) + 1);
+  const rational128 wide_hi((rational128::integer_t(1) << 90) + 1,
+                            (rational128::integer_t(1) << 90) + 2);
+  assert_true(wide_lo < wide_hi);
+  assert_true(wide_hi.compare(wide_lo) > 0);
+#endif
+}
+
+void test::op_read() {
+  cout << "Test: Read\n";
+
+  stringstream in("9/16 -5/3 7 4/0");
+  rational frac(0);
+  in >> frac;
+  assert_true(frac == rational(9, 16));
+  in >> frac;
+  assert_true(frac == rational(-5, 3));
+  in >> frac;
+  assert_true(frac == rational(7));
+  in >> frac;
+  assert_true(in.fail());
+  assert_true(frac == rational(7));
+}
+
+void test::parse_chars() {
+  cout << "Test: Parse Chars\n";
+
+  const std::string text("-18/12");
+  rational frac(0);
+  auto result = rational::from_chars(text.data(), text.data() + text.size(),
+                                     frac);
+  assert_true(result.ec == std::errc());
+  assert_true(result.ptr == text.data() + text.size());
+  assert_true(frac == rational(-3, 2));
+
+  const std::string canon("21/43");
+  result = rational::from_chars(canon.data(), canon.data() + canon.size(),
+                                frac, true);
+  assert_true(result.ec == std::errc());
+  assert_equals(21, frac.numerator());
+  assert_equals(43, frac.denominator());
+
+  const std::string whole("-9,tail");
+  result = rational::from_chars(whole.data(), whole.data() + whole.size(),
+                                frac);
+  assert_true(result.ec == std::errc());
+  assert_equals(',', *result.ptr);
+  assert_true(frac == rational(-9));
+
+  const std::string bad("x/2");
+  result = rational::from_chars(bad.data(), bad.data() + bad.size(), frac);
+  assert_true(result.ec == std::errc::invalid_argument);
+  assert_true(result.ptr == bad.data());
+
+  const std::string zero_denom("3/0");
+  result = rational::from_chars(zero_denom.data(),
+                                zero_denom.data() + zero_denom.size(), frac);
+  assert_true(result.ec == std::errc::invalid_argument);
+
+  const std::string huge("99999999999999999999/3");
+  result = rational::from_chars(huge.data(), huge.data() + huge.size(), frac);
+  assert_true(result.ec == std::errc::result_out_of_range);
+}
+
+void test::binary_records() {
+  cout << "Test: Binary Records\n";
+
+  const rational frac(-7, 3);
+  const auto record = frac.to_packed();
+  assert_equals(-7, record.num);
+  assert_equals(3, record.denom);
+  assert_true(rational::from_packed(record) == frac);
+  assert_true(sizeof(rational::packed) == 16);
+
+  std::vector<rational> values;
+  for (rational::integer_t denom = 1; denom <= 32; ++denom) {
+    values.emplace_back(denom - 16, denom);
+  }
+  stringstream buffer(ios_base::in | ios_base::out | ios_base::binary);
+  serialize::write_records(buffer, values);
+
+  const auto copied = serialize::read_records<rational::integer_t>(buffer);
+  assert_equals(values.size(), copied.size());
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    assert_true(values[i] == copied[i]);
+  }
+
+  // The in-memory array doubles as the mapped file image.
+  const auto view = serialize::map_records<rational::integer_t>(
+      values.data(), values.size() * sizeof(rational));
+  assert_equals(values.size(), view.size());
+  assert_true(view[3] == values[3]);
+  std::size_t seen = 0;
+  for (const auto& mapped : view) {
+    assert_true(mapped == values[seen++]);
+  }
+}
+
+void test::approximate() {
+  cout << "Test: Approximate\n";
+
+  // Convergents of pi: 3, 22/7, 333/106, 355/113, 103993/33102.
+  const rational pi_like(103993, 33102);
+  assert_true(pi_like.approximate(1000) == rational(355, 113));
+  assert_true(pi_like.approximate(113) == rational(355, 113));
+  assert_true(pi_like.approximate(100) == rational(311, 99));
+  assert_true(pi_like.approximate(1) == rational(3));
+  assert_true((-pi_like).approximate(100) == rational(-311, 99));
+
+  // Already under the cap: returned unchanged.
+  const rational small(5, 6);
+  assert_true(small.approximate(10) == small);
+
+  assert_true(rational(127, 128).approximate(100) == rational(99, 100));
+  // Tie on a halved final term once compared against the CF tail
+  // instead of the original value and picked the worse side.
+  assert_true(rational(41443682, 98581597).approximate(1000) ==
+              rational(169, 402));
+}
+
+void test::from_double() {
+  cout << "Test: From Double\n";
+
+  assert_true(rational::from_double(0.5, 10) == rational(1, 2));
+  assert_true(rational::from_double(-0.5, 10) == rational(-1, 2));
+  assert_true(rational::from_double(3.0, 10) == rational(3));
+  assert_true(rational::from_double(0.0, 10) == rational(0));
+
+  const rational third(1, 3);
+  assert_true(rational::from_double(third.value(), 1000) == third);
+
+  const rational mile(355, 113);
+  assert_true(rational::from_double(mile.value(), 113) == mile);
+  assert_true(rational::from_double(mile.value(), 100) == rational(311, 99));
+}
+
+void test::parallel_reduce() {
+  cout << "Test: Parallel Reduce\n";
+
+  std::vector<rational> values;
+  for (rational::integer_t i = 1; i <= 5000; ++i) {
+    values.emplace_back((i % 19) - 9, (i % 8) + 1);
+  }
+  rational serial(0);
+  for (const auto& frac : values) serial += frac;
+  assert_true(reduce::sum(values.begin(), values.end()) == serial);
+  assert_true(reduce::sum(values.begin(), values.end(), 3) == serial);
+  assert_true(reduce::sum(values.begin(), values.begin()) == rational(0));
+
+  // Telescoping product i/(i+1), which reduces to 1/(count+1).
+  std::vector<rational> factors;
+  for (rational::integer_t i = 1; i <= 4000; ++i) {
+    factors.emplace_back(i, i + 1);
+  }
+  rational serial_prod(1);
+  for (const auto& frac : factors) serial_prod *= frac;
+  assert_true(reduce::product(factors.begin(), factors.end()) == serial_prod);
+  assert_true(reduce::product(factors.begin(), factors.end(), 5) ==
+              serial_prod);
+  assert_true(reduce::product(factors.begin(), factors.begin()) ==
+              rational(1));
+}
+
+void test::series_ops() {
+  cout << "Test: Series\n";
+
+  rational_series<rational::integer_t> left(10000);
+  rational_series<rational::integer_t> right(10000);
+  for (rational::integer_t i = 0; i < 100; ++i) {
+    left.push_back(i * 3 - 50);
+    right.push_back(rational(i, 100));
+  }
+  assert_equals(10000, left.denominator());
+  assert_true(left.at(0) == rational(-50, 10000));
+  assert_true(right.at(7) == rational(7, 100));
+
+  auto sum = left;
+  sum += right;
+  assert_equals(std::size_t(100), sum.size());
+  assert_true(sum.at(4) == left.at(4) + right.at(4));
+  sum -= right;
+  assert_true(sum == left);
+
+  // Mismatched bases rebase through the lcm.
+  rational_series<rational::integer_t> eighths(8);
+  rational_series<rational::integer_t> sixths(6);
+  for (rational::integer_t i = 1; i <= 4; ++i) {
+    eighths.push_back(i);
+    sixths.push_back(i);
+  }
+  auto mixed = eighths;
+  mixed += sixths;
+  assert_equals(24, mixed.denominator());
+  assert_true(mixed.at(1) == rational(2, 8) + rational(2, 6));
+
+  const auto mask = eighths.less(sixths);
+  for (std::size_t i = 0; i < mask.size(); ++i) {
+    assert_equals(1, int(mask[i]));
+  }
+
+  auto scaled = eighths;
+  scaled.scale(rational(2, 3));
+  assert_true(scaled.at(2) == rational(3, 8) * rational(2, 3));
+
+  const auto round_trip =
+      rational_series<rational::integer_t>(8, eighths.to_rationals());
+  assert_true(round_trip == eighths);
+}
+
+void test::expr_fusion() {
+  cout << "Test: Expression Fusion\n";
+
+  const rational a(3, 4);
+  const rational b(5, 6);
+  const rational c(-7, 8);
+  const rational d(9, 10);
+
+  const rational dot = expr(a) * b + expr(c) * d;
+  assert_true(dot == a * b + c * d);
+
+  const rational chain = (expr(a) - b) * c / d;
+  assert_true(chain == (a - b) * c / d);
+
+  // Wide intermediates survive where the plain operators would overflow.
+  const rational big(1, 3000000000);
+  const rational fused = expr(big) * big / (expr(big) * big);
+  assert_true(fused == rational(1));
+
+  constexpr rational folded = expr(rational(1, 2)) + rational(1, 3);
+  assert_true(folded == rational(5, 6));
+}
+
+void test::checked_ops() {
+  cout << "Test: Checked Arithmetic\n";
+
+  using checked = rational_checked<std::int64_t>;
+  checked acc(3, 4);
+  acc += checked(5, 6);
+  acc *= checked(-2, 19);
+  assert_true(acc.value() == (rational(3, 4) + rational(5, 6)) * rational(-2, 19));
+  acc -= checked(1, 3);
+  acc /= checked(7);
+  assert_true(acc.value() ==
+              ((rational(3, 4) + rational(5, 6)) * rational(-2, 19) -
+               rational(1, 3)) /
+                  rational(7));
+
+  const checked huge(std::numeric_limits<std::int64_t>::max() - 1, 3);
+  bool caught = false;
+  try {
+    const auto blown = huge * huge;
+    assert_true(blown.numerator() == 0);
+  } catch (const std::overflow_error&) {
+    caught = true;
+  }
+  assert_true(caught);
+
+  caught = false;
+  try {
+    acc /= checked(0);
+  } catch (const std::invalid_argument&) {
+    caught = true;
+  }
+  assert_true(caught);
+}
+
+void test::linear_algebra() {
+  cout << "Test: Linear Algebra\n";
+
+  linalg::matrix<std::int64_t> mat(3, 3);
+  mat(0, 0) = rational(1, 2);
+  mat(0, 1) = rational(1, 3);
+  mat(0, 2) = rational(1);
+  mat(1, 0) = rational(2);
+  mat(1, 1) = rational(-1, 4);
+  mat(1, 2) = rational(0);
+  mat(2, 0) = rational(1, 5);
+  mat(2, 1) = rational(1);
+  mat(2, 2) = rational(-1, 2);
+
+  const auto det = linalg::determinant(mat);
+  assert_true(det == rational(587, 240));
+
+  const std::vector<rational> rhs{rational(1), rational(-2), rational(3, 7)};
+  const auto solution = linalg::solve(mat, rhs);
+  for (std::size_t row = 0; row < 3; ++row) {
+    auto accum = rational(0);
+    for (std::size_t col = 0; col < 3; ++col) {
+      accum += mat(row, col) * solution[col];
+    }
+    assert_true(accum == rhs[row]);
+  }
+
+  linalg::matrix<std::int64_t> singular(2, 2);
+  singular(0, 0) = rational(1, 2);
+  singular(0, 1) = rational(1, 3);
+  singular(1, 0) = rational(3, 2);
+  singular(1, 1) = rational(1);
+  assert_true(linalg::determinant(singular) == rational(0));
+  bool caught = false;
+  try {
+    linalg::solve(singular, {rational(1), rational(2)});
+  } catch (const std::invalid_argument&) {
+    caught = true;
+  }
+  assert_true(caught);
+}
+
+void test::literal_constants() {
+  cout << "Test: Literal Constants\n";
+  using namespace rational_literals;
+
+  constexpr auto third = 1_r / 3_r;
+  static_assert(third.numerator() == 1 && third.denominator() == 3,
+                "Literal quotients must fold at compile time.");
+
+  constexpr auto pi_like = rational_c<355, 113>;
+  static_assert(pi_like.numerator() == 355 && pi_like.denominator() == 113,
+                "rational_c must hold the canonical constant.");
+  static_assert(rational_c<-18, -12> == rational_c<3, 2>,
+                "rational_c must reduce during translation.");
+
+  assert_true(7_r / 22_r == rational(7, 22));
+  assert_true(rational_c<10> == rational(10));
+}
+
+void test::hybrid_sort() {
+  cout << "Test: Hybrid Sort\n";
+
+  std::vector<rational> values;
+  for (std::int64_t i = 0; i < 400; ++i) {
+    values.emplace_back(((i * 37) % 83) - 41, (i * 53) % 29 + 1);
+  }
+  // Exact ties whose keys collide, plus neighbors one ulp-scale apart.
+  values.emplace_back(1, 3);
+  values.emplace_back(2, 6);
+  values.emplace_back(1000000000000000000, 2999999999999999999);
+  auto expected = values;
+  std::sort(expected.begin(), expected.end());
+  sort::rationals(values);
+  assert_true(values == expected);
+
+  std::vector<rational> tiny{rational(1, 2)};
+  sort::rationals(tiny);
+  assert_true(tiny.front() == rational(1, 2));
+}
+
+void test::intern_handles() {
+  cout << "Test: Intern Handles\n";
+
+  static_assert(sizeof(rational_interned<>) == 4,
+                "Handles must pack to four bytes.");
+
+  const rational_interned<> half(rational(1, 2));
+  const rational_interned<> same(rational(-3, -6));
+  assert_true(half == same);
+  assert_true(half != rational_interned<>(rational(1, 3)));
+  assert_true(rational_interned<>(rational(1, 3)) < half);
+
+  const rational widened = half;
+  assert_true(widened == rational(1, 2));
+  assert_true(half.numerator() == 1 && half.denominator() == 2);
+
+  assert_true(rational_interned<>::fits(rational(-32767, 32767)));
+  assert_true(!rational_interned<>::fits(rational(32768)));
+  bool caught = false;
+  try {
+    const rational_interned<> blown(rational(1, 40000));
+    assert_true(blown.denominator() == 0);
+  } catch (const std::invalid_argument&) {
+    caught = true;
+  }
+  assert_true(caught);
+}
+
+void test::stats_report() {
+  cout << "Test: Stats Report\n";
+
+  rational_stats::reset();
+  auto acc = rational(1, 6);
+  acc += rational(3, 10);
+  acc *= rational(5, 7);
+  stringstream stream;
+  rational_stats::report(stream);
+  assert_true(!stream.str().empty());
+#ifdef DEBUG
+  assert_true(rational_stats::tally.adds >= 1);
+  assert_true(rational_stats::tally.muls >= 1);
+  assert_true(rational_stats::tally.simplifies >= 1);
+#endif
+  rational_stats::reset();
+}
+
+void test::integer_pow() {
+  cout << "Test: Integer Pow\n";
+
+  const rational base(-2, 3);
+  assert_true(base.pow(0) == rational(1));
+  assert_true(base.pow(1) == base);
+  assert_true(base.pow(4) == rational(16, 81));
+  assert_true(base.pow(5) == rational(-32, 243));
+  assert_true(base.pow(-3) == rational(27, -8));
+  assert_true(rational(0).pow(3) == rational(0));
+
+  constexpr auto folded = rational_c<3, 7>.pow(2);
+  static_assert(folded.numerator() == 9 && folded.denominator() == 49,
+                "pow must fold at compile time.");
+
+  bool caught = false;
+  try {
+    const auto blown = rational(0).pow(-1);
+    assert_true(blown == rational(0));
+  } catch (const std::invalid_argument&) {
+    caught = true;
+  }
+  assert_true(caught);
+}
+
+void test::format_chars() {
+  cout << "Test: Format Chars\n";
+
+  char buffer[64];
+  const rational frac(-22, 7);
+  auto result = frac.to_chars(buffer, buffer + sizeof(buffer));
+  assert_true(result.ec == std::errc());
+  assert_equals(std::string("-22/7"), std::string(buffer, result.ptr));
+
+  rational round_trip(0);
+  rational::from_chars(buffer, result.ptr, round_trip);
+  assert_true(round_trip == frac);
+
+  char tight[4];
+  result = frac.to_chars(tight, tight + sizeof(tight));
+  assert_true(result.ec == std::errc::value_too_large);
+
+  assert_equals(std::string("-3.142857"), frac.to_decimal(6));
+  assert_equals(std::string("0.3333333333"), rational(1, 3).to_decimal(10));
+  assert_equals(std::string("5"), rational(10, 2).to_decimal(0));
+  assert_equals(std::string("0.50"), rational(1, 2).to_decimal(2));
+}
+
+void test::from_value_recovery() {
+  cout << "Test: From Value Recovery\n";
+
+  const rational cases[] = {rational(0),       rational(-7),
+                            rational(1, 3),    rational(-355, 113),
+                            rational(22, 7),   rational(5, 4096),
+                            rational(981, 17), rational(1, 1000000007)};
+  for (const auto& expected : cases) {
+    assert_true(rational::from_value(expected.value()) == expected);
+  }
+
+  // 0.1 is not representable, but 1/10 is the minimal fraction rounding
+  // to its double.
+  assert_true(rational::from_value(0.1) == rational(1, 10));
+
+  bool caught = false;
+  try {
+    rational::from_value(1.0 / 0.0);
+  } catch (const std::invalid_argument&) {
+    caught = true;
+  }
+  assert_true(caught);
+}
+
+void test::stream_folds() {
+  cout << "Test: Stream Folds\n";
+
+  std::vector<rational> values;
+  auto expected = rational(0);
+  for (std::int64_t i = 0; i < 3000; ++i) {
+    const rational sample(((i * 13) % 21) - 10, (i % 8) + 1);
+    values.push_back(sample);
+    expected += sample;
+  }
+  stringstream packed(std::ios_base::in | std::ios_base::out |
+                      std::ios_base::binary);
+  serialize::write_records(packed, values);
+
+  // Small blocks force several loader handoffs.
+  assert_true(stream::sum<std::int64_t>(packed, 256) == expected);
+
+  packed.clear();
+  packed.seekg(0);
+  const auto extremes = stream::minmax<std::int64_t>(packed, 256);
+  assert_true(extremes.first == *std::min_element(values.begin(), values.end()));
+  assert_true(extremes.second == *std::max_element(values.begin(), values.end()));
+
+  packed.clear();
+  packed.seekg(0);
+  std::vector<rational> unique_check = values;
+  sort::rationals(unique_check);
+  const auto tail = std::unique(unique_check.begin(), unique_check.end());
+  const auto distinct = static_cast<std::size_t>(
+      std::distance(unique_check.begin(), tail));
+  assert_true(stream::count_distinct<std::int64_t>(packed, 256) == distinct);
+
+  stringstream empty(std::ios_base::in | std::ios_base::binary);
+  assert_true(stream::sum<std::int64_t>(empty) == rational(0));
+}
+
+void test::inplace_mutators() {
+  cout << "Test: Inplace Mutators\n";
+
+  rational frac(-3, 7);
+  frac.invert();
+  assert_equals(-7, frac.numerator());
+  assert_equals(3, frac.denominator());
+  frac.invert();
+  assert_true(frac == rational(-3, 7));
+
+  frac.negate();
+  assert_true(frac == rational(3, 7));
+  frac.negate().negate();
+  assert_true(frac == rational(3, 7));
+
+  rational neg(-5, 9);
+  neg.make_abs();
+  assert_true(neg == rational(5, 9));
+  neg.make_abs();
+  assert_true(neg == rational(5, 9));
+
+  rational zero(0);
+  bool caught = false;
+  try {
+    zero.invert();
+  } catch (const std::invalid_argument&) {
+    caught = true;
+  }
+  assert_true(caught);
+  assert_true(zero == rational(0));
+}
+
+void test::parallel_transforms() {
+  cout << "Test: Parallel Transforms\n";
+
+  std::vector<rational> column;
+  for (std::int64_t i = 0; i < 20000; ++i) {
+    column.emplace_back(((i * 31) % 59) - 29, (i % 16) + 1);
+  }
+  auto expected = column;
+  for (auto& frac : expected) frac *= rational(3, 5);
+  auto scaled = column;
+  parallel::for_each(scaled.begin(), scaled.end(),
+                     [](rational& frac) { frac *= rational(3, 5); });
+  assert_true(scaled == expected);
+
+  std::vector<rational> doubled(column.size(), rational(0));
+  parallel::transform(column.begin(), column.end(), doubled.begin(),
+                      [](const rational& frac) { return frac + frac; });
+  for (std::size_t i = 0; i < column.size(); ++i) {
+    assert_true(doubled[i] == column[i] * rational(2));
+  }
+
+  // Mid-sized ranges once drove the chunk sampler past the end.
+  std::vector<rational> mid;
+  for (std::int64_t i = 0; i < 100; ++i) mid.emplace_back(i - 50, 7);
+  auto mid_expected = mid;
+  for (auto& frac : mid_expected) frac += rational(1, 2);
+  parallel::for_each(mid.begin(), mid.end(),
+                     [](rational& frac) { frac += rational(1, 2); });
+  assert_true(mid == mid_expected);
+
+  std::vector<rational> none;
+  parallel::for_each(none.begin(), none.end(), [](rational&) {});
+  assert_true(none.empty());
+}